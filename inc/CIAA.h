@@ -94,6 +94,44 @@ extern "C" {
 #define TEC_4_GPIO 1
 #define TEC_4_BIT  9
 
+// Puerto SSP1 usado por las pantallas con registros de desplazamiento, P1_4 es también el LED rojo del poncho
+#define SPI_MOSI_PORT 1
+#define SPI_MOSI_PIN  4
+#define SPI_MOSI_FUNC SCU_MODE_FUNC5
+
+#define SPI_SCK_PORT  0xF
+#define SPI_SCK_PIN   4
+#define SPI_SCK_FUNC  SCU_MODE_FUNC0
+
+#define SPI_SSEL_PORT 1
+#define SPI_SSEL_PIN  20
+#define SPI_SSEL_FUNC SCU_MODE_FUNC1
+
+// Puerto USART2, conectado al puerto de depuración USB de la placa
+#define UART_TXD_PORT 7
+#define UART_TXD_PIN  1
+#define UART_TXD_FUNC SCU_MODE_FUNC6
+
+#define UART_RXD_PORT 7
+#define UART_RXD_PIN  2
+#define UART_RXD_FUNC SCU_MODE_FUNC6
+
+// Puerto USART3, conectado al transceptor RS-232 de la placa
+#define RS232_TXD_PORT 2
+#define RS232_TXD_PIN  3
+#define RS232_TXD_FUNC SCU_MODE_FUNC2
+
+#define RS232_RXD_PORT 2
+#define RS232_RXD_PIN  4
+#define RS232_RXD_FUNC SCU_MODE_FUNC2
+
+// Terminal GPIO0 del conector de expansión
+#define GPIO_0_PORT 6
+#define GPIO_0_PIN  1
+#define GPIO_0_FUNC SCU_MODE_FUNC0
+#define GPIO_0_GPIO 3
+#define GPIO_0_BIT  0
+
 /* === Public data type declarations =============================================================================== */
 
 /* === Public variable declarations ================================================================================ */
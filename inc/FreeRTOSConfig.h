@@ -45,9 +45,9 @@
 #define configSUPPORT_STATIC_ALLOCATION  0
 
 #define configUSE_PREEMPTION             1
-#define configUSE_IDLE_HOOK              0
+#define configUSE_IDLE_HOOK              1
 #define configUSE_TICKLESS_IDLE          0
-#define configUSE_TICK_HOOK              0
+#define configUSE_TICK_HOOK              1
 #define configCPU_CLOCK_HZ               (SystemCoreClock)
 #define configTICK_RATE_HZ               ((TickType_t)1000) // 1000 ticks per second => 1ms tick rate
 #define configMAX_PRIORITIES             (15)
@@ -60,12 +60,39 @@
 #define configIDLE_SHOULD_YIELD          1
 #define configUSE_MUTEXES                1
 #define configQUEUE_REGISTRY_SIZE        8
-#define configCHECK_FOR_STACK_OVERFLOW   0
+#define configCHECK_FOR_STACK_OVERFLOW   2
 #define configUSE_RECURSIVE_MUTEXES      1
 #define configUSE_MALLOC_FAILED_HOOK     0
 #define configUSE_APPLICATION_TASK_TAG   0
 #define configUSE_COUNTING_SEMAPHORES    1
-#define configGENERATE_RUN_TIME_STATS    0
+#define configGENERATE_RUN_TIME_STATS    1
+
+/* Run time statistics definitions, implemented in monitor.c */
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+#include <stdint.h>
+void MonitorTimerInit(void);
+uint32_t MonitorTimerGetCount(void);
+void MonitorTaskSwitchedIn(uint32_t number);
+#endif /* defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__) */
+
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() MonitorTimerInit()
+#define portGET_RUN_TIME_COUNTER_VALUE()         MonitorTimerGetCount()
+#define traceTASK_SWITCHED_IN()                                                                                        \
+    do {                                                                                                               \
+        MonitorTaskSwitchedIn(pxCurrentTCB->uxTCBNumber);                                                              \
+        TraceRecord(TRACE_EVENT_TASK_SWITCH, 0, pxCurrentTCB->uxTCBNumber);                                            \
+    } while (0)
+
+/* Binary trace recorder, implemented in trace.c */
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+#include "trace.h"
+#endif /* defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__) */
+
+#define traceEVENT_GROUP_SET_BITS(group, bits)          TraceRecord(TRACE_EVENT_GROUP_SET, 0, (bits))
+#define traceEVENT_GROUP_SET_BITS_FROM_ISR(group, bits) TraceRecord(TRACE_EVENT_GROUP_SET, 1, (bits))
+#define traceEVENT_GROUP_WAIT_BITS_BLOCK(group, bits)   TraceRecord(TRACE_EVENT_GROUP_BLOCK, 0, (bits))
+#define traceEVENT_GROUP_WAIT_BITS_END(group, bits, timeout)                                                           \
+    TraceRecord(TRACE_EVENT_GROUP_WAKE, ((timeout) != 0), (bits))
 
 /* Co-routine definitions. */
 #define configUSE_CO_ROUTINES           0
@@ -34,8 +34,11 @@ extern "C" {
 
 /* === Public macros definitions =================================================================================== */
 
+#include "console.h"
 #include "digital.h"
 #include "screen.h"
+#include "settings.h"
+#include "sync.h"
 
 /* === Public data type declarations =============================================================================== */
 
@@ -47,7 +50,11 @@ typedef struct board_s {
     digital_input_t increment;
     digital_input_t accept;
     digital_input_t cancel;
+    digital_group_t keys; // Todas las teclas: aceptar, cancelar, incrementar, decrementar, ajustar hora y alarma
     screen_t screen;
+    settings_storage_t settings;
+    console_port_t console; // Puerto serie de depuración, con la recepción ya en marcha
+    sync_port_t sync;       // Puerto serie de la referencia de hora, solo recepción
 
     digital_output_t led_R;
     digital_output_t led_G;
@@ -58,12 +65,34 @@ typedef struct board_s {
     digital_output_t led_green;
 } const * board_t;
 
+//! Contadores de escrituras a los puertos de segmentos realizadas por el driver de pantalla
+typedef struct board_screen_writes_s {
+    uint32_t issued;  /**< Escrituras realizadas porque algún segmento o el punto cambió */
+    uint32_t skipped; /**< Escrituras evitadas porque los segmentos ya tenían el valor pedido */
+} board_screen_writes_t;
+
 /* === Public variable declarations ================================================================================ */
 
 /* === Public function declarations ================================================================================ */
 
+/**
+ * @brief Crea la placa inicializando solamente la pantalla y la memoria de configuración.
+ * @return Placa creada, con las teclas, los LEDs y el zumbador todavía sin crear.
+ */
 board_t BoardCreate(void);
 
+/**
+ * @brief Inicializa las teclas, los LEDs y el zumbador de la placa creada con BoardCreate.
+ * @note Se llama después de que la pantalla ya muestra la hora, para no demorar el primer refresco.
+ */
+void BoardCreatePeripherals(void);
+
+/**
+ * @brief Obtiene los contadores de escrituras a los segmentos de la pantalla.
+ * @param writes Puntero donde se copiarán los contadores.
+ */
+void BoardGetScreenWrites(board_screen_writes_t * writes);
+
 /* === End of conditional blocks =================================================================================== */
 
 #ifdef __cplusplus
@@ -0,0 +1,84 @@
+/*********************************************************************************************************************
+Copyright (c) 2025, Martín Fernando Gareca del autor <mfgareca36@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*********************************************************************************************************************/
+
+#ifndef BCD_H_
+#define BCD_H_
+
+/** @file bcd.h
+ ** @brief Declaración de funciones de conversión de horas en BCD desempaquetado
+ **/
+
+/* === Headers files inclusions ==================================================================================== */
+
+#include "clock.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/* === Header for C++ compatibility ================================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =================================================================================== */
+
+#define BCD_SECONDS_PER_DAY 86400 /**< Segundos de un día completo */
+
+/* === Public data type declarations =============================================================================== */
+
+/* === Public variable declarations ================================================================================ */
+
+/* === Public function declarations ================================================================================ */
+
+/**
+ * @brief Verifica que los seis dígitos formen una hora entre 00:00:00 y 23:59:59.
+ * @param time Hora a verificar.
+ * @return true si la hora es válida, false en caso contrario.
+ */
+bool BcdTimeIsValid(const clock_time_t * time);
+
+/**
+ * @brief Incrementa la hora en un segundo propagando el acarreo por todos los dígitos, volviendo a 00:00:00 después
+ *        de 23:59:59.
+ * @param time Hora a incrementar, debe ser válida.
+ * @return true si la hora volvió a 00:00:00 y comienza un nuevo día, false en caso contrario.
+ */
+bool BcdTimeIncrement(clock_time_t * time);
+
+/**
+ * @brief Convierte la hora a segundos desde la medianoche.
+ * @param time Hora a convertir, debe ser válida.
+ * @return Segundos desde la medianoche.
+ */
+uint32_t BcdTimeToSeconds(const clock_time_t * time);
+
+/**
+ * @brief Convierte segundos desde la medianoche a una hora en BCD.
+ * @param time Puntero donde se almacenará la hora.
+ * @param seconds Segundos desde la medianoche, se toma el resto de dividir por BCD_SECONDS_PER_DAY.
+ */
+void BcdTimeFromSeconds(clock_time_t * time, uint32_t seconds);
+
+/* === End of conditional blocks =================================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BCD_H_ */
@@ -0,0 +1,99 @@
+/*********************************************************************************************************************
+Copyright (c) 2025, Martín Fernando Gareca del autor <mfgareca36@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*********************************************************************************************************************/
+
+#ifndef BUZZER_H_
+#define BUZZER_H_
+
+/** @file buzzer.h
+ ** @brief Declaración de funciones y macros para la reproducción de melodías en el zumbador
+ **/
+
+/* === Headers files inclusions ==================================================================================== */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* === Header for C++ compatibility ================================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =================================================================================== */
+
+#define BUZZER_VOLUME_MAX 16 /**< Volumen máximo, ciclo de trabajo del 50% */
+
+/* === Public data type declarations =============================================================================== */
+
+//! Nota de una melodía
+typedef struct buzzer_note_s {
+    uint16_t frequency;   /**< Frecuencia del tono en Hz, 0 para un silencio */
+    uint16_t duration_ms; /**< Duración de la nota en milisegundos */
+} buzzer_note_t;
+
+//! Melodía formada por una secuencia de notas almacenada en flash
+typedef struct buzzer_melody_s {
+    const buzzer_note_t * notes; /**< Notas de la melodía */
+    uint8_t count;               /**< Cantidad de notas */
+} buzzer_melody_t;
+
+/* === Public variable declarations ================================================================================ */
+
+/* === Public function declarations ================================================================================ */
+
+/**
+ * @brief Configura el temporizador que genera los tonos sobre el pin del zumbador.
+ * @param gpio Puerto GPIO del zumbador, ya configurado como salida.
+ * @param bit Número de bit del zumbador dentro del puerto.
+ */
+void BuzzerInit(uint8_t gpio, uint8_t bit);
+
+/**
+ * @brief Reproduce una melodía en segundo plano.
+ * @param melody Melodía a reproducir, debe permanecer válida mientras suena.
+ * @param volume Volumen entre 1 y BUZZER_VOLUME_MAX.
+ * @param repeat Indica si la melodía se repite hasta llamar a BuzzerStop.
+ * @return 0 si la melodía comenzó a sonar, -1 si los parámetros son inválidos.
+ */
+int BuzzerPlay(const buzzer_melody_t * melody, uint8_t volume, bool repeat);
+
+/**
+ * @brief Reproduce el sonido de alarma, que aumenta el volumen y la intensidad del patrón a medida que pasa el tiempo.
+ * @note Toda la secuencia avanza en la interrupción de fin de nota, sin intervención de ninguna tarea.
+ */
+void BuzzerAlarmStart(void);
+
+/**
+ * @brief Detiene cualquier sonido y deja el zumbador apagado.
+ */
+void BuzzerStop(void);
+
+/**
+ * @brief Indica si el zumbador está reproduciendo una melodía.
+ * @return true si está sonando, false en caso contrario.
+ */
+bool BuzzerIsPlaying(void);
+
+/* === End of conditional blocks =================================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BUZZER_H_ */
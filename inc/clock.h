@@ -37,6 +37,13 @@ extern "C" {
 #include <stdint.h>
 #include <stdbool.h>
 
+#define CLOCK_YEAR_MIN 1900 /**< Primer año aceptado por el calendario */
+#define CLOCK_YEAR_MAX 2399 /**< Último año aceptado por el calendario, después vuelve a CLOCK_YEAR_MIN */
+
+#define CLOCK_EVERY_DAY 0x7F /**< Máscara de días de alarma con todos los días de la semana */
+#define CLOCK_WORKDAYS  0x3E /**< Máscara de días de alarma de lunes a viernes */
+#define CLOCK_WEEKEND   0x41 /**< Máscara de días de alarma de sábado y domingo */
+
 /* === Public data type declarations =============================================================================== */
 
 typedef union {
@@ -48,8 +55,23 @@ typedef union {
     uint8_t bcd[6];
 } clock_time_t;
 
+//! Fecha del calendario gregoriano
+typedef struct clock_date_s {
+    uint16_t year;   /**< Año, entre CLOCK_YEAR_MIN y CLOCK_YEAR_MAX */
+    uint8_t month;   /**< Mes, de 1 a 12 */
+    uint8_t day;     /**< Día del mes, de 1 a 31 */
+    uint8_t weekday; /**< Día de la semana, 0 para domingo hasta 6 para sábado */
+} clock_date_t;
+
 typedef struct clock_s * clock_t;
 
+/**
+ * @brief Función que recibe un aviso del reloj.
+ * Se ejecuta en el contexto que llama a ClockNewTick, por lo que debe ser breve.
+ * @param context Puntero entregado al registrar la función.
+ */
+typedef void (*clock_event_t)(void * context);
+
 /**
  * @brief Función para crear un reloj.
  * Inicializa el reloj con una hora inválida (00:00) y un indicador de validez en falso.
@@ -85,10 +107,11 @@ void ClockNewTick(clock_t clock);
 
 /**
  * @brief Función para establecer una alarma en el reloj.
- * Copia la hora de la alarma proporcionada en alarm_time a self->alarm_time y marca la alarma como válida.
+ * Copia la hora de la alarma proporcionada en alarm_time a self->alarm_time y marca la alarma como válida, sin
+ * cambiar la validez de la hora del reloj.
  * @param self Puntero al reloj.
  * @param alarm_time Puntero a la hora de la alarma que se desea establecer.
- * @return Verdadero si se estableció la alarma correctamente, falso si el reloj no es válido.
+ * @return Verdadero si se estableció la alarma correctamente.
  */
 bool ClockSetAlarm(clock_t self, const clock_time_t * alarm_time);
 
@@ -97,7 +120,7 @@ bool ClockSetAlarm(clock_t self, const clock_time_t * alarm_time);
  * Copia en alarm_time la hora de la alarma almacenada en self->alarm_time.
  * @param self Puntero al reloj.
  * @param alarm_time Puntero donde se almacenará la hora de la alarma.
- * @return Verdadero si se obtuvo la hora de la alarma correctamente, falso si el reloj no es válido.
+ * @return Verdadero si la alarma fue configurada, falso si nunca se estableció o se reinició.
  */
 bool ClockGetAlarm(clock_t self, clock_time_t * alarm_time);
 
@@ -160,6 +183,154 @@ bool ClockPostponeAlarmRandomMinutes(clock_t self, uint8_t minutes);
  */
 void ClockPostponeAlarmOneDay(clock_t self);
 
+/**
+ * @brief Función para obtener la fecha actual del reloj.
+ * @param self Puntero al reloj.
+ * @param date Puntero donde se almacenará la fecha actual, con su día de la semana.
+ * @return Verdadero si la fecha fue establecida, falso si todavía tiene el valor inicial.
+ */
+bool ClockGetDate(clock_t self, clock_date_t * date);
+
+/**
+ * @brief Función para establecer la fecha del reloj.
+ * El día de la semana se calcula a partir de la fecha, el valor recibido en date->weekday se ignora.
+ * @param self Puntero al reloj.
+ * @param date Puntero a la nueva fecha.
+ * @return Verdadero si la fecha es válida y se estableció, falso en caso contrario.
+ */
+bool ClockSetDate(clock_t self, const clock_date_t * date);
+
+/**
+ * @brief Función para ajustar la hora, la fecha y la fase dentro del segundo a partir de una referencia externa.
+ * @param self Puntero al reloj.
+ * @param time Hora en el instante de referencia, con sus segundos.
+ * @param date Fecha en el instante de referencia, NULL para conservar la fecha actual.
+ * @param elapsed_ms Milisegundos transcurridos desde el instante de referencia.
+ * @return Verdadero si la hora y la fecha son válidas y se establecieron, falso en caso contrario.
+ * @note No debe ejecutarse al mismo tiempo que ClockNewTick; quien la llama se encarga de la exclusión.
+ */
+bool ClockSync(clock_t self, const clock_time_t * time, const clock_date_t * date, uint32_t elapsed_ms);
+
+/**
+ * @brief Función para alinear el comienzo de los segundos con un pulso externo que marca cada segundo.
+ * El segundo que el reloj tenía más cercano al pulso pasa a comenzar exactamente en el pulso.
+ * @param self Puntero al reloj.
+ * @param elapsed_ms Milisegundos transcurridos desde el pulso, menos de 1000.
+ * @return Corrección aplicada en milisegundos, positiva si el reloj estaba atrasado y negativa si estaba adelantado.
+ * @note No debe ejecutarse al mismo tiempo que ClockNewTick; quien la llama se encarga de la exclusión.
+ */
+int16_t ClockAlignSecond(clock_t self, uint16_t elapsed_ms);
+
+/**
+ * @brief Función para obtener los milisegundos transcurridos desde el comienzo del segundo actual.
+ * @param self Puntero al reloj.
+ * @return Milisegundos, de 0 a 999.
+ */
+uint16_t ClockGetMilliseconds(clock_t self);
+
+/**
+ * @brief Función para establecer los días de la semana en los que suena la alarma.
+ * @param self Puntero al reloj.
+ * @param days Máscara con un bit por día, el bit 0 es el domingo y el bit 6 el sábado.
+ */
+void ClockSetAlarmDays(clock_t self, uint8_t days);
+
+/**
+ * @brief Función para obtener los días de la semana en los que suena la alarma.
+ * @param self Puntero al reloj.
+ * @return Máscara con un bit por día, el bit 0 es el domingo y el bit 6 el sábado.
+ */
+uint8_t ClockGetAlarmDays(clock_t self);
+
+/**
+ * @brief Función para obtener la cantidad de días de un mes.
+ * @param year Año, necesario para febrero en los años bisiestos.
+ * @param month Mes, de 1 a 12.
+ * @return Cantidad de días del mes, 0 si el mes es inválido.
+ */
+uint8_t ClockDaysInMonth(uint16_t year, uint8_t month);
+
+/**
+ * @brief Función para calcular el día de la semana de una fecha en tiempo constante.
+ * @param year Año, entre CLOCK_YEAR_MIN y CLOCK_YEAR_MAX.
+ * @param month Mes, de 1 a 12.
+ * @param day Día del mes.
+ * @return Día de la semana, 0 para domingo hasta 6 para sábado.
+ */
+uint8_t ClockWeekday(uint16_t year, uint8_t month, uint8_t day);
+
+/**
+ * @brief Función para poner en marcha o detener el cronómetro.
+ * El cronómetro avanza con ClockNewTick, un milisegundo por tick, sin afectar a la hora ni a la alarma.
+ * @param self Puntero al reloj.
+ * @param run Verdadero para ponerlo en marcha, falso para detenerlo conservando el tiempo medido.
+ */
+void ClockStopwatchRun(clock_t self, bool run);
+
+/**
+ * @brief Función para volver el cronómetro a cero, sin cambiar si está en marcha.
+ * @param self Puntero al reloj.
+ */
+void ClockStopwatchReset(clock_t self);
+
+/**
+ * @brief Función para leer el tiempo medido por el cronómetro.
+ * @param self Puntero al reloj.
+ * @return Milisegundos medidos desde la última puesta a cero.
+ */
+uint32_t ClockStopwatchRead(clock_t self);
+
+/**
+ * @brief Función para tomar una vuelta del cronómetro.
+ * @param self Puntero al reloj.
+ * @return Milisegundos desde la vuelta anterior, o desde la puesta a cero si es la primera.
+ */
+uint32_t ClockStopwatchLap(clock_t self);
+
+/**
+ * @brief Función para saber si el cronómetro está en marcha.
+ * @param self Puntero al reloj.
+ * @return Verdadero si el cronómetro está en marcha, falso en caso contrario.
+ */
+bool ClockStopwatchIsRunning(clock_t self);
+
+/**
+ * @brief Función para cargar el tiempo de la cuenta regresiva, que queda detenida.
+ * @param self Puntero al reloj.
+ * @param milliseconds Duración de la cuenta regresiva, 0 para descartarla.
+ */
+void ClockCountdownSet(clock_t self, uint32_t milliseconds);
+
+/**
+ * @brief Función para poner en marcha o detener la cuenta regresiva.
+ * @param self Puntero al reloj.
+ * @param run Verdadero para ponerla en marcha, falso para detenerla conservando el tiempo restante.
+ * @return Verdadero si quedó en el estado pedido, falso si se pidió ponerla en marcha sin tiempo restante.
+ */
+bool ClockCountdownRun(clock_t self, bool run);
+
+/**
+ * @brief Función para leer el tiempo restante de la cuenta regresiva.
+ * @param self Puntero al reloj.
+ * @return Milisegundos que faltan para que termine la cuenta.
+ */
+uint32_t ClockCountdownRead(clock_t self);
+
+/**
+ * @brief Función para saber si la cuenta regresiva está en marcha.
+ * @param self Puntero al reloj.
+ * @return Verdadero si la cuenta regresiva está en marcha, falso en caso contrario.
+ */
+bool ClockCountdownIsRunning(clock_t self);
+
+/**
+ * @brief Función para registrar el aviso de fin de la cuenta regresiva.
+ * @param self Puntero al reloj.
+ * @param handler Función que se llama una vez cuando la cuenta llega a cero, NULL para no avisar.
+ * @param context Puntero que se entrega a la función.
+ */
+void ClockCountdownOnExpire(clock_t self, clock_event_t handler, void * context);
+
 /**
  * @brief Función para aumentar la cantidad de minutos.
  * Incrementa los minutos de la hora actual del reloj.
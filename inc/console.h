@@ -0,0 +1,109 @@
+/*********************************************************************************************************************
+Copyright (c) 2025, Martín Fernando Gareca del autor <mfgareca36@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*********************************************************************************************************************/
+
+#ifndef CONSOLE_H_
+#define CONSOLE_H_
+
+/** @file console.h
+ ** @brief Declaración de la consola de órdenes y telemetría por puerto serie
+ **/
+
+/* === Headers files inclusions ==================================================================================== */
+
+#include "FreeRTOS.h"
+#include "clock.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* === Header for C++ compatibility ================================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =================================================================================== */
+
+#ifndef CONSOLE_RX_SIZE
+#define CONSOLE_RX_SIZE 512 /**< Bytes del buffer circular de recepción, potencia de dos, 44 ms a 115200 baudios */
+#endif
+
+#ifndef CONSOLE_TX_SIZE
+#define CONSOLE_TX_SIZE 1024 /**< Bytes del buffer circular de transmisión, potencia de dos */
+#endif
+
+#define CONSOLE_LINE_MAX  48 /**< Longitud máxima de una orden, las más largas se descartan completas */
+#define CONSOLE_PERIOD_MS 20 /**< Período con el que la tarea revisa lo recibido y arranca los envíos */
+
+#define CONSOLE_TASK_STACK_SIZE (2 * configMINIMAL_STACK_SIZE)
+
+/* === Public data type declarations =============================================================================== */
+
+//! Puerto serie de la consola, la placa lo implementa con DMA y en el host se puede reemplazar por una pseudo-terminal
+typedef struct console_port_s {
+    uint8_t * rx_buffer;                                  /**< Buffer circular de CONSOLE_RX_SIZE bytes */
+    uint16_t (*RxPosition)(void);                         /**< Posición donde el puerto escribirá el próximo byte */
+    void (*TxStart)(const uint8_t * data, uint16_t size); /**< Comienza a enviar un bloque, sin esperar */
+    bool (*TxBusy)(void);                                 /**< Indica si el último bloque todavía se está enviando */
+} const * console_port_t;
+
+//! Argumentos de la tarea de consola
+typedef struct console_task_args_s {
+    console_port_t port; /**< Puerto serie de la consola */
+    clock_t clock;       /**< Reloj que se consulta y se ajusta */
+} * console_task_args_t;
+
+/* === Public variable declarations ================================================================================ */
+
+/* === Public function declarations ================================================================================ */
+
+/**
+ * @brief Prepara la consola sobre un puerto ya inicializado.
+ * @param port Puerto serie con la recepción en marcha.
+ * @param clock Reloj que se consulta y se ajusta.
+ * @note Existe una única consola.
+ */
+void ConsoleInit(console_port_t port, clock_t clock);
+
+/**
+ * @brief Ejecuta las órdenes completas recibidas y arranca el envío de las respuestas pendientes.
+ * @note Nunca espera al puerto: las líneas se interpretan dentro del buffer de recepción, sin copiarlas, y si el
+ *       buffer de transmisión se llena las respuestas se recortan y se cuentan como descartadas.
+ */
+void ConsolePoll(void);
+
+/**
+ * @brief Tarea que atiende la consola cada CONSOLE_PERIOD_MS milisegundos.
+ * @param pointer Puntero a los argumentos de la tarea, del tipo console_task_args_t.
+ * @note Órdenes aceptadas, una por línea:
+ *       - ayuda: lista las órdenes.
+ *       - hora [HH:MM[:SS]]: muestra o ajusta la hora.
+ *       - fecha [AAAA-MM-DD]: muestra o ajusta la fecha.
+ *       - alarma [HH:MM]: muestra o ajusta la hora de la alarma; se activa y desactiva con las teclas.
+ *       - utc [+HH:MM]: muestra o ajusta la diferencia de la hora local con la UTC de las sentencias RMC.
+ *       - estado: vuelca las estadísticas de tareas, memoria, servicio, consumo y traza.
+ */
+void ConsoleTask(void * pointer);
+
+/* === End of conditional blocks =================================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONSOLE_H_ */
@@ -37,6 +37,12 @@ extern "C" {
 
 /* === Public macros definitions =================================================================================== */
 
+#define DIGITAL_GROUP_MAX_INPUTS 32 /**< Cantidad máxima de entradas de un grupo, una por bit de la máscara */
+#define DIGITAL_GROUP_MAX_PORTS  8  /**< Cantidad máxima de puertos distintos en un grupo */
+
+#define DIGITAL_DEBOUNCE_BITS        4  /**< Bits de los contadores verticales del filtro antirrebote */
+#define DIGITAL_DEBOUNCE_MAX_SAMPLES 15 /**< Máximo de lecturas iguales que puede exigir el filtro antirrebote */
+
 /* === Public data type declarations =============================================================================== */
 
 typedef enum digital_state_e {
@@ -51,6 +57,17 @@ typedef struct digital_output_s * digital_output_t;
 //! Estructura que representa una entrada digital
 typedef struct digital_input_s * digital_input_t;
 
+//! Grupo de entradas digitales que se leen juntas, con una lectura por puerto
+typedef struct digital_group_s * digital_group_t;
+
+//! Estado de un grupo de entradas, el bit i corresponde a la entrada i del grupo
+typedef struct digital_snapshot_s {
+    uint32_t active;      /*!< Entradas activas, ya corregidas por inversión y filtradas contra rebotes */
+    uint32_t changed;     /*!< Entradas que cambiaron desde la lectura anterior */
+    uint32_t activated;   /*!< Entradas que pasaron a activas desde la lectura anterior */
+    uint32_t deactivated; /*!< Entradas que pasaron a inactivas desde la lectura anterior */
+} digital_snapshot_t;
+
 /* === Public variable declarations ================================================================================ */
 
 /* === Public function declarations ================================================================================ */
@@ -60,20 +77,23 @@ typedef struct digital_input_s * digital_input_t;
  *
  * @param gpio El puerto del pin
  * @param bit El número del pin
+ * @param inverted Indica si la salida digital está invertida
  * @return digital_output_t
+ * @note No configura el pin: la placa fija su dirección y su estado inicial con la tabla de pines, en una sola
+ *       escritura por puerto.
  */
-digital_output_t DigitalOutputCreate(uint8_t gpio, uint8_t bit, bool state);
+digital_output_t DigitalOutputCreate(uint8_t gpio, uint8_t bit, bool inverted);
 
 /**
  * @brief Activa una salida digital
- * @param self La salida digital
+ * @param self La salida digital, NULL si la placa no la tiene y la llamada se ignora
  * @return void
  */
 void DigitalOutputActivate(digital_output_t self);
 
 /**
  * @brief Desactiva una salida digital
- * @param self La salida digital
+ * @param self La salida digital, NULL si la placa no la tiene y la llamada se ignora
  * @return void
  */
 void DigitalOutputDeactivate(digital_output_t self);
@@ -81,7 +101,7 @@ void DigitalOutputDeactivate(digital_output_t self);
 /**
  * @brief Cambia el estado de la salida digital
  *
- * @param self La salida digital
+ * @param self La salida digital, NULL si la placa no la tiene y la llamada se ignora
  */
 void DigitalOutputToggle(digital_output_t self);
 
@@ -92,6 +112,7 @@ void DigitalOutputToggle(digital_output_t self);
  * @param bit El número del pin
  * @param inverted Indica si la entrada digital está invertida
  * @return ditial_input_t
+ * @note El pin ya debe estar configurado como entrada por la tabla de pines de la placa.
  */
 digital_input_t DigitalInputCreate(uint8_t gpio, uint8_t bit, bool inverted);
 
@@ -127,6 +148,37 @@ bool DigitalWasActivated(digital_input_t input);
  */
 bool DigitalWasDeactivated(digital_input_t input);
 
+/**
+ * @brief Crea un grupo con entradas digitales ya creadas
+ *
+ * @param inputs Entradas del grupo, la entrada i ocupa el bit i de las máscaras
+ * @param count Cantidad de entradas, hasta DIGITAL_GROUP_MAX_INPUTS
+ * @return digital_group_t El grupo creado, NULL si los parámetros son inválidos o no hay memoria
+ */
+digital_group_t DigitalGroupCreate(const digital_input_t inputs[], uint8_t count);
+
+/**
+ * @brief Lee todas las entradas del grupo con una sola lectura de cada puerto
+ *
+ * @param group El grupo de entradas
+ * @param snapshot Puntero donde se almacenan las entradas activas y sus cambios respecto de la lectura anterior
+ */
+void DigitalGroupRead(digital_group_t group, digital_snapshot_t * snapshot);
+
+/**
+ * @brief Configura el filtro antirrebote de algunas entradas del grupo
+ *
+ * Una entrada cambia de estado recién cuando DigitalGroupRead la lee con el nuevo valor en la cantidad de lecturas
+ * consecutivas indicada, por lo que el tiempo estable es samples veces el período de lectura. Todas las entradas se
+ * filtran juntas con contadores verticales, con unas pocas operaciones de bits por lectura.
+ *
+ * @param group El grupo de entradas
+ * @param inputs Máscara de las entradas a configurar, el bit i corresponde a la entrada i del grupo
+ * @param samples Lecturas iguales necesarias, de 1 (sin filtro, el valor inicial) a DIGITAL_DEBOUNCE_MAX_SAMPLES
+ * @return int 0 si se configuró, -1 si la cantidad de lecturas es inválida
+ */
+int DigitalGroupSetDebounce(digital_group_t group, uint32_t inputs, uint8_t samples);
+
 /* === End of conditional blocks =================================================================================== */
 
 #ifdef __cplusplus
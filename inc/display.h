@@ -40,15 +40,67 @@ extern "C" {
 
 /* === Public macros definitions =================================================================================== */
 
+#ifndef SERVICE_MAX_HOOKS
+#define SERVICE_MAX_HOOKS 4 /**< Cantidad máxima de funciones adicionales llamadas cada milisegundo */
+#endif
+
+#define SERVICE_BUDGET_US 50 /**< Tiempo máximo de una pasada del servicio, el 5% de cada milisegundo */
+
 /* === Public data type declarations =============================================================================== */
 
+/**
+ * @brief Función llamada por el servicio una vez por milisegundo.
+ * @param context Puntero entregado al registrar la función.
+ */
+typedef void (*service_hook_t)(void * context);
+
+//! Argumentos de la tarea de servicio
+typedef struct service_args_s {
+    clock_t clock;   /**< Reloj que avanza un tick por milisegundo */
+    screen_t screen; /**< Pantalla que se multiplexa un dígito por milisegundo */
+} * service_args_t;
+
 /* === Public variable declarations ================================================================================ */
 
 /* === Public function declarations ================================================================================ */
 
-void RefreshScreenTask(void * args);
-
-void TickTask(void * pointer);
+/**
+ * @brief Registra una función adicional que el servicio llama cada milisegundo, después del reloj y la pantalla.
+ * @param hook Función a llamar, debe terminar en pocos microsegundos y no bloquearse.
+ * @param context Puntero que se entrega a la función.
+ * @return 0 si se registró, -1 si no hay lugar o la función es inválida.
+ * @note Las funciones se registran desde una sola tarea, normalmente durante el arranque.
+ */
+int ServiceAddHook(service_hook_t hook, void * context);
+
+/**
+ * @brief Devuelve la duración más larga de una pasada del servicio.
+ * @return Duración en microsegundos, a comparar con SERVICE_BUDGET_US.
+ */
+uint32_t ServiceWorstCaseUs(void);
+
+/**
+ * @brief Devuelve la duración más larga de una pasada del servicio en ciclos del procesador.
+ * @return Duración en ciclos, para comparar compilaciones con y sin RAMFUNC_DISABLE.
+ */
+uint32_t ServiceWorstCaseCycles(void);
+
+/**
+ * @brief Devuelve la cantidad de pasadas del servicio que superaron SERVICE_BUDGET_US.
+ * @return Pasadas medidas por encima del presupuesto desde el arranque.
+ */
+uint32_t ServiceOverruns(void);
+
+/**
+ * @brief Tarea única de 1 kHz que avanza el reloj y refresca la pantalla.
+ * Cada milisegundo, en este orden: avanza el reloj (con sus cronómetros y alarma), refresca un dígito de la
+ * pantalla y llama a las funciones registradas con ServiceAddHook, en el orden en que se registraron.
+ * Cada pasada completa, funciones adicionales incluidas, se mide con el contador de ciclos del núcleo y debe entrar
+ * en SERVICE_BUDGET_US. Cada nuevo peor caso queda en el registro de traza como TRACE_EVENT_SERVICE, y
+ * ServiceWorstCaseUs y ServiceOverruns lo informan en la consola.
+ * @param pointer Argumentos del tipo service_args_t.
+ */
+void ServiceTask(void * pointer);
 
 /* === End of conditional blocks =================================================================================== */
 
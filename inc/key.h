@@ -51,21 +51,32 @@ extern "C" {
 
 #define KEY_TASK_STACK_SIZE (2 * configMINIMAL_STACK_SIZE)
 
+#define KEY_SCAN_PERIOD_MS  5    /**< Período de lectura de las teclas */
+#define KEY_DEBOUNCE_MS     20   /**< Tiempo que una tecla debe mantener su valor para cambiar de estado */
+#define KEY_LONG_PRESS_MS   3000 /**< Tiempo que se debe mantener presionada una tecla de pulsación larga */
+
 /* === Public data type declarations =============================================================================== */
 
 typedef struct key_task_args_s {
     EventGroupHandle_t event_group;
-    uint8_t event_bit;
-    digital_input_t gpio;
+    digital_group_t keys; // La entrada i del grupo genera el evento KEY_EVENT_KEY_i
+    uint8_t long_press;   // Teclas que generan su evento recién después de KEY_LONG_PRESS_MS presionadas
+    uint16_t debounce_ms; // Tiempo estable de todas las teclas, 0 para usar KEY_DEBOUNCE_MS
 } * key_task_args_t;
 
 /* === Public variable declarations ================================================================================ */
 
 /* === Public function declarations ================================================================================ */
 
-void KeyTask(void * args);
-
-void LargeKeyTask(void * args);
+/**
+ * @brief Tarea que explora todas las teclas de un grupo con una lectura por puerto en cada período.
+ * Las teclas comunes generan su evento al presionarse, las de pulsación larga una sola vez al cumplir el tiempo.
+ * El filtro antirrebote del grupo se configura al arrancar con el tiempo estable pedido, redondeado hacia abajo a
+ * un múltiplo de KEY_SCAN_PERIOD_MS y limitado entre una y DIGITAL_DEBOUNCE_MAX_SAMPLES lecturas (de 5 a 75 ms);
+ * cada tecla puede luego ajustarse por separado con DigitalGroupSetDebounce.
+ * @param args Argumentos del tipo key_task_args_t.
+ */
+void KeyScanTask(void * args);
 
 /* === End of conditional blocks =================================================================================== */
 
@@ -0,0 +1,158 @@
+/*********************************************************************************************************************
+Copyright (c) 2025, Martín Fernando Gareca del autor <mfgareca36@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*********************************************************************************************************************/
+
+#ifndef MONITOR_H_
+#define MONITOR_H_
+
+/** @file monitor.h
+ ** @brief Declaración de funciones y macros para el monitoreo de tareas, pilas y memoria del sistema.
+ **/
+
+/* === Headers files inclusions ==================================================================================== */
+
+#include "FreeRTOS.h"
+#include <stdint.h>
+#include <stddef.h>
+
+/* === Header for C++ compatibility ================================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =================================================================================== */
+
+#ifndef MONITOR_MAX_TASKS
+#define MONITOR_MAX_TASKS 16 /**< Cantidad máxima de tareas que se reportan */
+#endif
+
+#ifndef MONITOR_TIMER_HZ
+#define MONITOR_TIMER_HZ 100000 /**< Frecuencia del contador de tiempo de ejecución (10 us de resolución) */
+#endif
+
+#ifndef MONITOR_PERIOD_MS
+#define MONITOR_PERIOD_MS 5000 /**< Período de actualización del reporte de la tarea de monitoreo */
+#endif
+
+#define MONITOR_TASK_STACK_SIZE (2 * configMINIMAL_STACK_SIZE)
+
+/* === Public data type declarations =============================================================================== */
+
+//! Etapas del arranque cuyo instante se registra
+typedef enum {
+    MONITOR_BOOT_SETUP,       /**< Relojes del sistema configurados */
+    MONITOR_BOOT_DISPLAY,     /**< Pantalla lista para refrescar */
+    MONITOR_BOOT_CLOCK,       /**< Hora recuperada y escrita en la pantalla */
+    MONITOR_BOOT_FIRST_DIGIT, /**< Planificador en marcha con la pantalla ya refrescada */
+    MONITOR_BOOT_PERIPHERALS, /**< Teclas, LEDs y zumbador inicializados */
+    MONITOR_BOOT_DONE,        /**< Todas las tareas creadas */
+    MONITOR_BOOT_PHASES,
+} monitor_boot_phase_t;
+
+//! Estadísticas de una tarea en el último período de medición
+typedef struct monitor_task_s {
+    const char * name;         /**< Nombre de la tarea */
+    uint8_t number;            /**< Número de tarea asignado por el sistema operativo */
+    uint8_t priority;          /**< Prioridad actual de la tarea */
+    uint16_t cpu_permille;     /**< Uso de CPU en el último período, en décimas de porcentaje */
+    uint32_t switches;         /**< Cantidad de veces que la tarea entró en ejecución en el último período */
+    uint16_t stack_free_words; /**< Mínimo espacio libre que tuvo la pila de la tarea (en palabras) */
+} monitor_task_t;
+
+//! Reporte completo del sistema
+typedef struct monitor_report_s {
+    uint32_t sequence;                       /**< Número de reporte, se incrementa en cada actualización */
+    uint32_t elapsed;                        /**< Duración del período medido, en cuentas del contador */
+    uint8_t task_count;                      /**< Cantidad de tareas válidas en el arreglo */
+    monitor_task_t tasks[MONITOR_MAX_TASKS]; /**< Estadísticas por tarea */
+    size_t heap_free;                        /**< Memoria libre actual en el heap */
+    size_t heap_minimum_free;                /**< Mínima memoria libre que tuvo el heap desde el arranque */
+    uint32_t boot[MONITOR_BOOT_PHASES];      /**< Instante de cada etapa del arranque, en cuentas del contador */
+} monitor_report_t;
+
+/* === Public variable declarations ================================================================================ */
+
+/* === Public function declarations ================================================================================ */
+
+/**
+ * @brief Configura el temporizador que sirve de base de tiempo para las estadísticas de ejecución.
+ * @note El sistema operativo la llama a través de portCONFIGURE_TIMER_FOR_RUN_TIME_STATS. Si el arranque ya lo
+ *       configuró para registrar sus etapas, el contador sigue corriendo sin reiniciarse.
+ */
+void MonitorTimerInit(void);
+
+/**
+ * @brief Obtiene el valor actual del contador de tiempo de ejecución.
+ * @note El sistema operativo la llama a través de portGET_RUN_TIME_COUNTER_VALUE.
+ * @return Cuentas transcurridas desde MonitorTimerInit a la frecuencia MONITOR_TIMER_HZ.
+ */
+uint32_t MonitorTimerGetCount(void);
+
+/**
+ * @brief Obtiene el contador de ciclos del procesador, habilitado por MonitorTimerInit.
+ * @return Ciclos transcurridos, para medir tramos cortos de código con resolución de un ciclo.
+ */
+uint32_t MonitorCycleCount(void);
+
+/**
+ * @brief Convierte una cantidad de ciclos del procesador a microsegundos con la frecuencia actual.
+ * @param cycles Ciclos a convertir.
+ * @return Microsegundos equivalentes.
+ */
+uint32_t MonitorCyclesToUs(uint32_t cycles);
+
+/**
+ * @brief Registra el instante en que terminó una etapa del arranque.
+ * @param phase Etapa que terminó.
+ */
+void MonitorBootMark(monitor_boot_phase_t phase);
+
+/**
+ * @brief Registra la entrada en ejecución de una tarea.
+ * @param number Número de tarea asignado por el sistema operativo.
+ * @note El sistema operativo la llama a través de traceTASK_SWITCHED_IN, debe ser muy corta.
+ */
+void MonitorTaskSwitchedIn(uint32_t number);
+
+/**
+ * @brief Genera un nuevo reporte con las estadísticas acumuladas desde el reporte anterior.
+ * @param report Puntero donde se almacenará el reporte, puede ser NULL para usar solamente el reporte interno.
+ * @return 0 si el reporte se generó correctamente, -1 si no se pudo obtener el estado del sistema.
+ */
+int MonitorUpdate(monitor_report_t * report);
+
+/**
+ * @brief Obtiene el último reporte generado sin volver a medir.
+ * @return Puntero al último reporte generado por MonitorUpdate.
+ */
+const monitor_report_t * MonitorGetReport(void);
+
+/**
+ * @brief Tarea que genera un reporte cada MONITOR_PERIOD_MS milisegundos.
+ * @param pointer No utilizado.
+ */
+void MonitorTask(void * pointer);
+
+/* === End of conditional blocks =================================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MONITOR_H_ */
@@ -0,0 +1,168 @@
+/*********************************************************************************************************************
+Copyright (c) 2025, Martín Fernando Gareca del autor <mfgareca36@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*********************************************************************************************************************/
+
+#ifndef POWER_H_
+#define POWER_H_
+
+/** @file power.h
+ ** @brief Declaración de funciones para el bajo consumo: reposo en la tarea inactiva y frecuencia según el modo
+ **/
+
+/* === Headers files inclusions ==================================================================================== */
+
+#include "chip.h"
+#include <stdint.h>
+
+/* === Header for C++ compatibility ================================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =================================================================================== */
+
+#ifndef POWER_DISPLAY_DIVIDER
+#define POWER_DISPLAY_DIVIDER 4 /**< División del reloj del núcleo en el modo de solo pantalla, 204 MHz / 4 = 51 MHz */
+#endif
+
+#ifndef POWER_MAX_HOOKS
+#define POWER_MAX_HOOKS 6 /**< Cantidad máxima de funciones avisadas en cada cambio de frecuencia */
+#endif
+
+/* === Public data type declarations =============================================================================== */
+
+//! Causa por la que el procesador salió del modo de bajo consumo
+typedef enum {
+    POWER_WAKE_TICK,    /**< Tick del sistema operativo */
+    POWER_WAKE_DISPLAY, /**< Temporizador de brillo o DMA de la pantalla */
+    POWER_WAKE_BUZZER,  /**< Temporizador de notas del zumbador */
+    POWER_WAKE_OTHER,   /**< Cualquier otra interrupción */
+    POWER_WAKE_SOURCES,
+} power_wake_t;
+
+//! Modo de funcionamiento, cada uno con su frecuencia del núcleo
+typedef enum {
+    POWER_MODE_ACTIVE,  /**< Frecuencia máxima, con teclas, ajustes, cronómetro o sonido en curso */
+    POWER_MODE_DISPLAY, /**< Frecuencia reducida, solo se muestra la hora y se espera la alarma */
+    POWER_MODES,
+} power_mode_t;
+
+//! Contadores acumulados desde el arranque
+typedef struct power_stats_s {
+    uint32_t sleeps;                    /**< Veces que la tarea inactiva detuvo el procesador */
+    uint32_t sleep_time;                /**< Tiempo detenido, en cuentas del contador del monitor */
+    uint32_t wakes[POWER_WAKE_SOURCES]; /**< Despertares por cada causa */
+    uint32_t switches;                  /**< Cambios de frecuencia realizados */
+    uint64_t mode_time[POWER_MODES];    /**< Tiempo en cada modo, en cuentas del contador del monitor */
+    uint64_t mode_sleep[POWER_MODES];   /**< Tiempo detenido dentro de cada modo, en las mismas cuentas */
+} power_stats_t;
+
+/**
+ * @brief Función avisada después de cada cambio de frecuencia del núcleo.
+ * @note Se llama desde la interrupción del tick, debe terminar en pocos microsegundos.
+ */
+typedef void (*power_clock_hook_t)(void);
+
+/* === Public variable declarations ================================================================================ */
+
+/* === Public function declarations ================================================================================ */
+
+/**
+ * @brief Detiene el procesador hasta la próxima interrupción y registra cuánto durmió y qué lo despertó.
+ * @note La llama la tarea inactiva a través de vApplicationIdleHook, con configUSE_IDLE_HOOK en 1.
+ * @note Se usa el modo sleep, el más profundo que es seguro aquí: el servicio de 1 kHz despierta al sistema cada
+ *       milisegundo y la pantalla multiplexada y el zumbador necesitan sus temporizadores en marcha. Los modos deep
+ *       sleep y power down del LPC4337 detienen esos relojes y rearrancar el PLL lleva más que un tick.
+ */
+void PowerIdle(void);
+
+/**
+ * @brief Obtiene los contadores de bajo consumo.
+ * @param stats Puntero donde se copian los contadores.
+ */
+void PowerGetStats(power_stats_t * stats);
+
+/**
+ * @brief Prepara el divisor que alimenta al núcleo en el modo de solo pantalla y empieza a medir el modo activo.
+ * @note Se llama una vez durante el arranque, con el PLL principal ya configurado y el contador del monitor en marcha.
+ */
+void PowerInit(void);
+
+/**
+ * @brief Registra una función que se llama después de cada cambio de frecuencia del núcleo.
+ * @param hook Función que recalcula la base de tiempo de un periférico alimentado por el reloj del núcleo.
+ * @return 0 si se registró, -1 si no hay lugar o la función es inválida.
+ */
+int PowerAddClockHook(power_clock_hook_t hook);
+
+/**
+ * @brief Solicita un modo de funcionamiento.
+ * @param mode Modo solicitado.
+ * @note El cambio se aplica en el próximo tick del sistema operativo, justo después de que el contador del tick se
+ *       recargó: el núcleo cambia entre el PLL principal y el divisor sin volver a enganchar el PLL, el tick se
+ *       reprograma para la nueva frecuencia y las funciones registradas recalculan sus temporizadores. El reloj
+ *       solo pierde la latencia de esa interrupción, un par de microsegundos, en cada cambio.
+ * @note Al volver al modo activo el núcleo pasa un tick a 102 MHz antes de llegar al PLL principal, como pide el
+ *       manual para subir por encima de 110 MHz; las funciones registradas se llaman en los dos pasos.
+ */
+void PowerSetMode(power_mode_t mode);
+
+/**
+ * @brief Mantiene la frecuencia actual del núcleo hasta la llamada a PowerReleaseMode que le corresponde.
+ * Los modos pedidos mientras tanto se aplican en el primer tick después de liberarla.
+ * @note Se usa alrededor de las operaciones de un periférico que no pueden cambiar de reloj a mitad de camino, como
+ *       la programación de una página de la EEPROM. Los pedidos se anidan.
+ */
+void PowerHoldMode(void);
+
+/**
+ * @brief Libera un pedido hecho con PowerHoldMode.
+ */
+void PowerReleaseMode(void);
+
+/**
+ * @brief Obtiene el modo de funcionamiento aplicado.
+ * @return Modo en el que está funcionando el núcleo.
+ */
+power_mode_t PowerGetMode(void);
+
+/**
+ * @brief Calcula el margen de procesamiento medido en un modo.
+ * @param mode Modo a consultar.
+ * @return Tiempo que el procesador estuvo detenido en ese modo, en milésimos del tiempo total en el modo.
+ */
+uint16_t PowerHeadroom(power_mode_t mode);
+
+/**
+ * @brief Cambia el prescaler de un temporizador para mantener su frecuencia de cuenta con el reloj actual.
+ * @param timer Temporizador a corregir.
+ * @param clock Reloj del temporizador.
+ * @param hz Frecuencia de cuenta deseada.
+ * @note Si el contador del prescaler ya superó el nuevo límite se lo lleva a ese límite, para que la próxima cuenta
+ *       llegue en el siguiente pulso de reloj en lugar de dar toda la vuelta.
+ */
+void PowerTimerSetRate(LPC_TIMER_T * timer, CHIP_CCU_CLK_T clock, uint32_t hz);
+
+/* === End of conditional blocks =================================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* POWER_H_ */
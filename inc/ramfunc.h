@@ -0,0 +1,96 @@
+/*********************************************************************************************************************
+Copyright (c) 2025, Martín Fernando Gareca del autor <mfgareca36@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*********************************************************************************************************************/
+
+#ifndef RAMFUNC_H_
+#define RAMFUNC_H_
+
+/** @file ramfunc.h
+ ** @brief Macros para ubicar en SRAM las funciones y tablas que se ejecutan cada milisegundo
+ **/
+
+/* === Headers files inclusions ==================================================================================== */
+
+/* === Header for C++ compatibility ================================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =================================================================================== */
+
+/*
+ * Los nombres de las secciones empiezan con .data, por lo que el patrón .data* del script de enlace las ubica en la
+ * SRAM con su imagen en la flash y el código de arranque las copia junto con las variables inicializadas, antes de
+ * llamar a main. Así no hace falta modificar el script de enlace ni el arranque, que pertenecen a muju. Se separan
+ * con un guion bajo y no con un punto: el ensamblador trata cualquier .data.* como datos y, al encontrar código en
+ * ella, advierte que los atributos de la sección son incorrectos.
+ *
+ * La memoria flash del LPC4337 está a más de 16 MB de la SRAM, fuera del alcance de una instrucción BL: dentro de
+ * la misma unidad long_call genera la llamada indirecta y desde otros archivos el enlazador agrega el salto largo.
+ *
+ * Una función en SRAM que llama a otra en la flash vuelve a pagar los estados de espera en cada llamada, por eso
+ * sus auxiliares se marcan con __raminline y se expanden siempre dentro de ella, aun compilando sin optimizar.
+ *
+ * Compilando con RAMFUNC_DISABLE todo queda en la flash, para comparar la duración de una pasada del servicio de
+ * 1 kHz (ServiceWorstCaseCycles) con y sin la ubicación en SRAM:
+ *     make CFLAGS+=-DRAMFUNC_DISABLE
+ */
+#if defined(__arm__) && defined(__GNUC__) && !defined(RAMFUNC_DISABLE)
+
+#ifndef __ramfunc
+#define __ramfunc __attribute__((section(".data_ramfunc"), noinline, long_call))
+#endif
+
+#ifndef __ramdata
+#define __ramdata __attribute__((section(".data_ramdata")))
+#endif
+
+#ifndef __raminline
+#define __raminline inline __attribute__((always_inline))
+#endif
+
+#else
+
+#ifndef __ramfunc
+#define __ramfunc /**< En el host y sin ubicación en SRAM no tiene efecto */
+#endif
+
+#ifndef __ramdata
+#define __ramdata
+#endif
+
+#ifndef __raminline
+#define __raminline inline
+#endif
+
+#endif
+
+/* === Public data type declarations =============================================================================== */
+
+/* === Public variable declarations ================================================================================ */
+
+/* === Public function declarations ================================================================================ */
+
+/* === End of conditional blocks =================================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RAMFUNC_H_ */
@@ -48,6 +48,12 @@ extern "C" {
 #define SEGMENT_G (1 << 6) /**< Segmento G */
 #define SEGMENT_P (1 << 7) /**< Punto decimal */
 
+#define SCREEN_BRIGHTNESS_MAX 15 /**< Nivel de brillo máximo, el dígito queda encendido todo el intervalo */
+
+#ifndef SCREEN_SCROLL_MAX
+#define SCREEN_SCROLL_MAX 32 /**< Cantidad máxima de caracteres de una marquesina */
+#endif
+
 /* === Public data type declarations =============================================================================== */
 
 typedef struct screen_s * screen_t;
@@ -58,10 +64,13 @@ typedef void (*segments_update_t)(uint8_t);
 
 typedef void (*digit_turn_on_t)(uint8_t);
 
+typedef void (*digit_dim_t)(uint8_t);
+
 typedef struct screen_driver_s {
     digits_turn_off_t DigitsTurnOff;  /**< Función para apagar todos los dígitos */
     segments_update_t SegmentsUpdate; /**< Función para actualizar los segmentos del dígito actual */
     digit_turn_on_t DigitTurnOn;      /**< Función para encender un dígito específico */
+    digit_dim_t DigitDim;             /**< Opcional: apaga el dígito tras duty/256 del intervalo de refresco */
 } const * screen_driver_t;
 
 /* === Public variable declarations ================================================================================ */
@@ -72,22 +81,58 @@ typedef struct screen_driver_s {
  * @brief Función para crear una nueva instancia de pantalla.
  * @param digits Número de dígitos que tendrá la pantalla.
  * @param driver Estructura con funciones de control de pantalla.
- * @return Puntero a la nueva instancia de pantalla.
- * @note Si el número de dígitos es mayor que SCREEN_MAX_DIGITS, se limitará al máximo permitido.
+ * @return Puntero a la nueva instancia de pantalla, NULL si digits es cero o no hay memoria.
+ * @note La memoria para el estado de los dígitos se reserva según la cantidad de dígitos pedida.
  */
 screen_t ScreenCreate(uint8_t digits, screen_driver_t driver);
 
+/**
+ * @brief Función para encadenar una pantalla a continuación de otra.
+ * @param self Puntero a la primera pantalla de la cadena.
+ * @param next Puntero a la pantalla que se agrega al final de la cadena, con su propio driver.
+ * @return 0 si la pantalla se encadenó correctamente, -1 si los parámetros son inválidos o si la
+ *         pantalla ya forma parte de la cadena.
+ * @note Cada llamada a ScreenRefresh sobre la primera pantalla avanza un dígito en todas las pantallas de la cadena,
+ *       así el tiempo de encendido de cada dígito depende solo de los dígitos de su pantalla y no de cuántas
+ *       pantallas se agreguen.
+ */
+int ScreenChain(screen_t self, screen_t next);
+
 /**
  * @brief Función para escribir un valor BCD en la pantalla.
  * @param screen Puntero al descriptor de la pantalla con la que se quiere operar.
- * @param value Array de valores BCD a escribir en la pantalla.
+ * @param value Array de valores BCD a escribir en la pantalla, comenzando por el dígito menos significativo.
  * @param size Tamaño del array de valores BCD.
  * @return void
+ * @note Los valores se alinean a la derecha de la pantalla y los dígitos sobrantes quedan apagados.
  */
 void ScreenWriteBCD(screen_t screen, uint8_t value[], uint8_t size);
 
 /**
- * @brief Función para refrescar la pantalla.
+ * @brief Función para escribir un texto en la pantalla.
+ * @param screen Puntero al descriptor de la pantalla con la que se quiere operar.
+ * @param text Texto terminado en cero, por ejemplo "AL", "Err", "On" u "OFF".
+ * @return 0 si el texto se escribió, -1 si el texto es nulo.
+ * @note El texto se alinea a la izquierda y se recorta al número de dígitos. Los caracteres se convierten con una
+ *       tabla al escribirlos, por lo que el refresco no tiene trabajo adicional. Los que no se pueden representar
+ *       con siete segmentos, como K, M, V, W o X, quedan apagados.
+ */
+int ScreenWriteText(screen_t screen, const char * text);
+
+/**
+ * @brief Función para mostrar un texto desplazándose de derecha a izquierda en forma continua.
+ * @param screen Puntero al descriptor de la pantalla con la que se quiere operar.
+ * @param text Texto terminado en cero, se recorta a SCREEN_SCROLL_MAX caracteres.
+ * @param divisor Barridos completos de la pantalla que dura cada cuadro de la marquesina.
+ * @return 0 si la marquesina comenzó, -1 si la pantalla o el texto son nulos o el divisor es cero.
+ * @note El texto se convierte a imágenes una sola vez y el refresco avanza los cuadros por su cuenta, por lo que no
+ *       hace falta volver a escribir la pantalla. La marquesina se detiene al escribir con ScreenWriteBCD o
+ *       ScreenWriteText. Un texto que entra en la pantalla no se desplaza, se muestra fijo como con ScreenWriteText.
+ */
+int ScreenScrollText(screen_t screen, const char * text, uint16_t divisor);
+
+/**
+ * @brief Función para refrescar la pantalla y todas las pantallas encadenadas a ella.
  * @param screen Puntero al descriptor de la pantalla con la que se quiere operar.
  * @return void
  */
@@ -121,6 +166,43 @@ int DisplayFlashDot(screen_t self, uint8_t digit, uint16_t divisor, bool flashin
  * @return void
  */
 int DotTurningOn(screen_t self, uint8_t digit, bool turning_on);
+
+/**
+ * @brief Función para elegir qué dígitos y puntos decimales parpadean.
+ * @param self Puntero al descriptor de la pantalla con la que se quiere operar.
+ * @param digits Máscara de dígitos que parpadean, el bit 0 corresponde al dígito 0.
+ * @param dots Máscara de puntos decimales que parpadean, solo afecta a los puntos encendidos.
+ * @param divisor Factor de división de la frecuencia de refresco para el parpadeo.
+ * @return 0 si se configuró el parpadeo, -1 si la pantalla es nula o el divisor es cero.
+ * @note Todos los dígitos y puntos comparten un único contador de fase, por lo que parpadean sincronizados. El
+ *       divisor es común a toda la pantalla y DisplayFlashDigits o DisplayFlashDot lo reemplazan si reciben otro.
+ */
+int ScreenFlashMask(screen_t self, uint32_t digits, uint32_t dots, uint16_t divisor);
+
+/**
+ * @brief Función para establecer el brillo de la pantalla.
+ * @param self Puntero al descriptor de la pantalla con la que se quiere operar.
+ * @param level Nivel de brillo entre 0 y SCREEN_BRIGHTNESS_MAX.
+ * @return 0 si el brillo se estableció correctamente, -1 si el nivel es inválido o el driver no soporta DigitDim.
+ * @note Cancela cualquier transición de brillo en curso.
+ */
+int ScreenSetBrightness(screen_t self, uint8_t level);
+
+/**
+ * @brief Función para cambiar el brillo de la pantalla en forma gradual.
+ * @param self Puntero al descriptor de la pantalla con la que se quiere operar.
+ * @param level Nivel de brillo final entre 0 y SCREEN_BRIGHTNESS_MAX.
+ * @param divisor Cantidad de barridos completos de la pantalla que dura cada paso de brillo.
+ * @return 0 si la transición se inició correctamente, -1 si el nivel es inválido o el driver no soporta DigitDim.
+ */
+int ScreenFadeBrightness(screen_t self, uint8_t level, uint16_t divisor);
+
+/**
+ * @brief Función para obtener el brillo actual de la pantalla.
+ * @param self Puntero al descriptor de la pantalla con la que se quiere operar.
+ * @return Nivel de brillo actual entre 0 y SCREEN_BRIGHTNESS_MAX.
+ */
+uint8_t ScreenGetBrightness(screen_t self);
 /* === End of conditional blocks =================================================================================== */
 
 #ifdef __cplusplus
@@ -0,0 +1,119 @@
+/*********************************************************************************************************************
+Copyright (c) 2025, Martín Fernando Gareca del autor <mfgareca36@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*********************************************************************************************************************/
+
+#ifndef SETTINGS_H_
+#define SETTINGS_H_
+
+/** @file settings.h
+ ** @brief Declaración de funciones y macros para el almacenamiento persistente de la configuración
+ **/
+
+/* === Headers files inclusions ==================================================================================== */
+
+#include "clock.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/* === Header for C++ compatibility ================================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =================================================================================== */
+
+#define SETTINGS_SLOT_SIZE 64 /**< Tamaño de cada registro en la memoria, divide al tamaño de página */
+#define SETTINGS_VERSION   2  /**< Versión del formato de settings_t, aumenta con cada campo nuevo */
+
+/* === Public data type declarations =============================================================================== */
+
+/**
+ * @brief Configuración que sobrevive a un corte de alimentación.
+ * @note Los campos nuevos se agregan siempre al final, valen cero por omisión y aumentan SETTINGS_VERSION. Un
+ *       registro de una versión anterior se recupera con los bytes que tenía y el resto en cero. Los registros del
+ *       formato sin versión, anterior a la versión 1, no se reconocen: al actualizar desde ese formato la
+ *       configuración vuelve una sola vez a los valores iniciales.
+ */
+typedef struct settings_s {
+    clock_time_t time;  /**< Última hora conocida */
+    clock_time_t alarm; /**< Hora de la alarma */
+    bool time_valid;    /**< Indica si la hora fue configurada */
+    bool alarm_valid;   /**< Indica si la alarma fue configurada */
+    bool alarm_enabled; /**< Indica si la alarma está habilitada */
+    uint8_t brightness; /**< Brillo de la pantalla */
+    clock_date_t date;  /**< Última fecha conocida */
+    bool date_valid;    /**< Indica si la fecha fue configurada */
+    uint8_t alarm_days; /**< Días de la semana en los que suena la alarma */
+    int16_t utc_offset; /**< Minutos que se suman a la hora UTC de la referencia, desde la versión 2 */
+} settings_t;
+
+/**
+ * @brief Función que lee bytes de la memoria persistente.
+ * @param offset Posición desde el inicio de la zona reservada.
+ */
+typedef void (*settings_read_t)(uint32_t offset, void * data, uint32_t size);
+
+/**
+ * @brief Función que escribe bytes en la memoria persistente.
+ * @param offset Posición desde el inicio de la zona reservada, siempre múltiplo de SETTINGS_SLOT_SIZE.
+ * @return true si la escritura terminó, false si falló.
+ */
+typedef bool (*settings_write_t)(uint32_t offset, const void * data, uint32_t size);
+
+//! Memoria donde se guardan los registros, la EEPROM de la placa o un archivo en el host
+typedef struct settings_storage_s {
+    uint32_t size;          /**< Tamaño de la zona reservada en bytes */
+    settings_read_t Read;   /**< Función para leer de la memoria */
+    settings_write_t Write; /**< Función para escribir en la memoria */
+} const * settings_storage_t;
+
+/* === Public variable declarations ================================================================================ */
+
+/* === Public function declarations ================================================================================ */
+
+/**
+ * @brief Recorre la memoria y recupera el último registro válido.
+ * @param storage Memoria donde se guardan los registros.
+ * @return true si se encontró un registro válido, false si la memoria está vacía o los parámetros son inválidos.
+ * @note Los registros se agregan en forma circular, por lo que todas las posiciones se desgastan por igual y un
+ *       corte durante una escritura solo invalida ese registro, conservando el anterior.
+ */
+bool SettingsInit(settings_storage_t storage);
+
+/**
+ * @brief Obtiene la configuración recuperada o guardada por última vez.
+ * @param settings Puntero donde se copiará la configuración.
+ * @return true si hay una configuración válida, false en caso contrario.
+ */
+bool SettingsLoad(settings_t * settings);
+
+/**
+ * @brief Agrega un registro con la configuración, si es distinta de la última guardada.
+ * @param settings Configuración a guardar.
+ * @return 0 si la configuración quedó guardada, -1 si no se pudo escribir.
+ */
+int SettingsSave(const settings_t * settings);
+
+/* === End of conditional blocks =================================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SETTINGS_H_ */
@@ -0,0 +1,75 @@
+/*********************************************************************************************************************
+Copyright (c) 2025, Martín Fernando Gareca del autor <mfgareca36@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*********************************************************************************************************************/
+
+#ifndef SPI_DISPLAY_H_
+#define SPI_DISPLAY_H_
+
+/** @file spi_display.h
+ ** @brief Declaración de funciones y macros del driver de pantalla con registros de desplazamiento en serie
+ **/
+
+/* === Headers files inclusions ==================================================================================== */
+
+#include "screen.h"
+#include <stdint.h>
+
+/* === Header for C++ compatibility ================================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =================================================================================== */
+
+#ifndef SPI_DISPLAY_MAX_DIGITS
+#define SPI_DISPLAY_MAX_DIGITS 8 /**< Cantidad máxima de registros de la cadena */
+#endif
+
+/* === Public data type declarations =============================================================================== */
+
+/**
+ * @brief Función que envía una trama completa a la cadena de registros.
+ * @param frame Bytes a desplazar, el primero termina en el último registro de la cadena.
+ * @param size Cantidad de bytes de la trama.
+ * @note La trama permanece sin cambios hasta el próximo envío, por lo que puede transferirse por DMA.
+ */
+typedef void (*spi_display_send_t)(const uint8_t * frame, uint8_t size);
+
+/* === Public variable declarations ================================================================================ */
+
+/* === Public function declarations ================================================================================ */
+
+/**
+ * @brief Crea el driver de pantalla para una cadena de registros 74HC595, uno por dígito.
+ * @param digits Cantidad de dígitos (registros) de la cadena.
+ * @param send Función que envía la trama, el puerto SSP de la placa o una función de prueba en el host.
+ * @return Driver para usar con ScreenCreate, NULL si los parámetros son inválidos.
+ * @note Cada registro mantiene su dígito encendido en forma estática, por lo que no hay multiplexado:
+ *       ScreenRefresh solo arma la trama y esta se envía una vez por barrido, únicamente si cambió.
+ * @note Existe una única instancia del driver.
+ */
+screen_driver_t SpiDisplayCreate(uint8_t digits, spi_display_send_t send);
+
+/* === End of conditional blocks =================================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPI_DISPLAY_H_ */
@@ -0,0 +1,145 @@
+/*********************************************************************************************************************
+Copyright (c) 2025, Martín Fernando Gareca del autor <mfgareca36@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*********************************************************************************************************************/
+
+#ifndef SYNC_H_
+#define SYNC_H_
+
+/** @file sync.h
+ ** @brief Declaración de la sincronización de la hora con una referencia externa por puerto serie y pulso por segundo
+ **/
+
+/* === Headers files inclusions ==================================================================================== */
+
+#include "FreeRTOS.h"
+#include "clock.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* === Header for C++ compatibility ================================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =================================================================================== */
+
+#ifndef SYNC_RX_SIZE
+#define SYNC_RX_SIZE 256 /**< Bytes del buffer circular de recepción, potencia de dos, 266 ms a 9600 baudios */
+#endif
+
+#define SYNC_PERIOD_MS 5 /**< Período con el que la tarea revisa lo recibido y los pulsos */
+
+#define SYNC_UTC_OFFSET_MIN (-12 * 60) /**< Menor diferencia con UTC en minutos, la del huso -12:00 */
+#define SYNC_UTC_OFFSET_MAX (14 * 60)  /**< Mayor diferencia con UTC en minutos, la del huso +14:00 */
+
+#define SYNC_FRAME_START 0xA5 /**< Primer byte de la trama binaria */
+#define SYNC_FRAME_SYNC  0x5A /**< Segundo byte de la trama binaria */
+#define SYNC_FRAME_SIZE  10   /**< Bytes de la trama binaria después de los dos de inicio */
+
+#define SYNC_TASK_STACK_SIZE (2 * configMINIMAL_STACK_SIZE)
+
+/* === Public data type declarations =============================================================================== */
+
+//! Estadísticas de la sincronización
+typedef struct sync_stats_s {
+    uint32_t messages; /**< Mensajes de hora aplicados, sentencias RMC o tramas binarias */
+    uint32_t rejected; /**< Mensajes descartados por formato, suma de verificación o valores inválidos */
+    uint32_t pulses;   /**< Pulsos por segundo recibidos */
+    int32_t offset_ms; /**< Última corrección aplicada, positiva si el reloj estaba atrasado */
+    bool pulse_locked; /**< El último mensaje se aplicó alineado a un pulso */
+} sync_stats_t;
+
+//! Puerto serie de la referencia, solo recepción: la placa lo implementa con DMA y en el host con datos simulados
+typedef struct sync_port_s {
+    uint8_t * rx_buffer;          /**< Buffer circular de SYNC_RX_SIZE bytes */
+    uint16_t (*RxPosition)(void); /**< Posición donde el puerto escribirá el próximo byte, de 0 a SYNC_RX_SIZE */
+} const * sync_port_t;
+
+//! Argumentos de la tarea de sincronización
+typedef struct sync_task_args_s {
+    sync_port_t port;    /**< Puerto serie de la referencia */
+    clock_t clock;       /**< Reloj que se sincroniza */
+} * sync_task_args_t;
+
+/* === Public variable declarations ================================================================================ */
+
+/* === Public function declarations ================================================================================ */
+
+/**
+ * @brief Prepara la sincronización sobre un puerto con la recepción ya en marcha.
+ * @param port Puerto serie de la referencia, NULL para usar solamente el pulso por segundo.
+ * @param clock Reloj que se sincroniza.
+ * @note Existe una única sincronización.
+ */
+void SyncInit(sync_port_t port, clock_t clock);
+
+/**
+ * @brief Registra un pulso por segundo, el instante en que comienza un segundo de la referencia.
+ * @note Se llama desde la interrupción del flanco, solo guarda el instante con el contador del monitor.
+ */
+void SyncPulse(void);
+
+/**
+ * @brief Interpreta los mensajes recibidos y aplica los pulsos registrados.
+ * @note Cada pulso alinea el comienzo de los segundos del reloj, con el error de un tick. Cada mensaje ajusta la hora
+ *       y la fecha: si llega con segundos enteros y hubo un pulso en el último segundo, el mensaje nombra el segundo
+ *       que comenzó en ese pulso; si no, se toma como la hora del momento en que se lo interpretó, con un error de
+ *       hasta SYNC_PERIOD_MS más la demora del emisor.
+ */
+void SyncPoll(void);
+
+/**
+ * @brief Fija la diferencia entre la hora local y UTC, que se suma a la hora de las sentencias RMC.
+ * @param minutes Minutos al este de Greenwich, entre SYNC_UTC_OFFSET_MIN y SYNC_UTC_OFFSET_MAX.
+ * @return true si se fijó, false si está fuera de rango.
+ * @note Puede llamarse antes de SyncInit, que la conserva.
+ */
+bool SyncSetUtcOffset(int16_t minutes);
+
+/**
+ * @brief Obtiene la diferencia entre la hora local y UTC.
+ * @return Minutos al este de Greenwich.
+ */
+int16_t SyncGetUtcOffset(void);
+
+/**
+ * @brief Obtiene las estadísticas de la sincronización.
+ * @param stats Puntero donde se copian las estadísticas.
+ */
+void SyncGetStats(sync_stats_t * stats);
+
+/**
+ * @brief Tarea que atiende la sincronización cada SYNC_PERIOD_MS milisegundos.
+ * @param pointer Puntero a los argumentos de la tarea, del tipo sync_task_args_t.
+ * @note Mensajes aceptados:
+ *       - Sentencias NMEA RMC de cualquier receptor ($GPRMC, $GNRMC...), con estado A y suma de verificación. Traen
+ *         la hora UTC, que se pasa a la local con SyncSetUtcOffset, cambiando de día si hace falta.
+ *       - Tramas binarias con la hora local, SYNC_FRAME_START, SYNC_FRAME_SYNC y SYNC_FRAME_SIZE bytes: año (dos
+ *         bytes, el menos significativo primero), mes, día, horas, minutos, segundos, milisegundos (dos bytes, el
+ *         menos significativo primero) y el O exclusivo de los nueve bytes anteriores.
+ */
+void SyncTask(void * pointer);
+
+/* === End of conditional blocks =================================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SYNC_H_ */
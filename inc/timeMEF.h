@@ -50,6 +50,8 @@ typedef struct time_task_args_s {
     uint8_t decrement;
     uint8_t set_time;
     uint8_t set_alarm;
+    uint8_t timer_expired; // Bit que se activa desde el tick cuando termina la cuenta regresiva
+    uint8_t timeout;       // Bit que activa el temporizador de software cuando vence el tiempo de un ajuste
     board_t board;
     clock_t clock;
 } * time_task_args_t;
@@ -60,6 +62,21 @@ typedef struct time_task_args_s {
 
 void MEFTask(void * pointer);
 
+/**
+ * @brief Ajusta la hora de la alarma desde otra tarea, igual que el ajuste con las teclas.
+ * @param clock Reloj que atiende la MEF.
+ * @param alarm Hora de la alarma, con los segundos en cero.
+ * @return true si se ajustó; la alarma queda configurada y se guarda en la próxima actualización de la hora.
+ * @note La alarma se activa y desactiva solamente con las teclas.
+ */
+bool MEFSetAlarm(clock_t clock, const clock_time_t * alarm);
+
+/**
+ * @brief Pide guardar la configuración después de cambiarla desde otra tarea.
+ * @note Se guarda en la próxima actualización de la hora, desde la tarea de la MEF, sin esperar el cambio de minuto.
+ */
+void MEFRequestSave(void);
+
 /* === End of conditional blocks =================================================================================== */
 
 #ifdef __cplusplus
@@ -0,0 +1,127 @@
+/*********************************************************************************************************************
+Copyright (c) 2025, Martín Fernando Gareca del autor <mfgareca36@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*********************************************************************************************************************/
+
+#ifndef TRACE_H_
+#define TRACE_H_
+
+/** @file trace.h
+ ** @brief Declaración del registro binario de eventos del sistema operativo y de la aplicación
+ **/
+
+/* === Headers files inclusions ==================================================================================== */
+
+#include <stdint.h>
+
+/* === Header for C++ compatibility ================================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =================================================================================== */
+
+#ifndef TRACE_BUFFER_RECORDS
+#define TRACE_BUFFER_RECORDS 1024 /**< Registros del buffer circular, potencia de dos (8 bytes cada uno) */
+#endif
+
+#define TRACE_MAGIC   0x45435254 /**< Marca "TRCE" al inicio del registro, para reconocerlo en un volcado */
+#define TRACE_VERSION 1          /**< Versión del formato, tools/trace_decode.py debe coincidir */
+
+#define TRACE_EVENT_NONE        0  /**< Registro sin usar */
+#define TRACE_EVENT_CLOCK       1  /**< Cambio de frecuencia del núcleo: arg8 anterior y arg16 nueva, en MHz */
+#define TRACE_EVENT_TASK_SWITCH 2  /**< Entrada en ejecución de una tarea: arg16 número de tarea */
+#define TRACE_EVENT_GROUP_SET   3  /**< Bits puestos en un grupo de eventos: arg8 1 desde una interrupción */
+#define TRACE_EVENT_GROUP_BLOCK 4  /**< Tarea bloqueada esperando bits de un grupo: arg16 bits esperados */
+#define TRACE_EVENT_GROUP_WAKE  5  /**< Fin de la espera de bits: arg8 1 si venció el tiempo, arg16 bits esperados */
+#define TRACE_EVENT_KEY         6  /**< Teclas detectadas: arg8 pulsaciones largas y arg16 todos los eventos */
+#define TRACE_EVENT_STATE       7  /**< Cambio de estado de la MEF: arg8 anterior y arg16 nuevo */
+#define TRACE_EVENT_SCREEN_BCD  8  /**< Escritura numérica: arg8 cantidad de dígitos, arg16 los cuatro primeros */
+#define TRACE_EVENT_SCREEN_TEXT 9  /**< Escritura de texto: arg8 longitud escrita, arg16 los dos primeros caracteres */
+#define TRACE_EVENT_SERVICE     10 /**< Nuevo peor caso del servicio: arg8 1 si supera el presupuesto, arg16 en us */
+#define TRACE_EVENTS            11 /**< Cantidad de eventos definidos */
+
+#define TRACE_ALL_EVENTS ((1UL << TRACE_EVENTS) - 1) /**< Máscara con todos los eventos habilitados */
+
+/* === Public data type declarations =============================================================================== */
+
+//! Registro de un evento, ocho bytes escritos con las interrupciones enmascaradas
+typedef struct trace_record_s {
+    uint32_t cycles; /**< Contador de ciclos del núcleo en el momento del evento */
+    uint8_t event;   /**< Evento registrado, uno de TRACE_EVENT_* */
+    uint8_t arg8;    /**< Primer dato del evento */
+    uint16_t arg16;  /**< Segundo dato del evento */
+} trace_record_t;
+
+//! Buffer circular completo, se vuelca tal cual desde el depurador para decodificarlo en la PC
+typedef struct trace_log_s {
+    uint32_t magic;                               /**< TRACE_MAGIC */
+    uint16_t version;                             /**< TRACE_VERSION */
+    uint16_t size;                                /**< TRACE_BUFFER_RECORDS */
+    volatile uint32_t head;                       /**< Eventos registrados desde el arranque */
+    volatile uint32_t mask;                       /**< Eventos habilitados, un bit por evento */
+    uint32_t core_mhz;                            /**< Frecuencia del núcleo al escribir el último registro */
+    trace_record_t records[TRACE_BUFFER_RECORDS]; /**< Registros, el más nuevo en (head - 1) % size */
+} trace_log_t;
+
+/* === Public variable declarations ================================================================================ */
+
+/* === Public function declarations ================================================================================ */
+
+/**
+ * @brief Escribe el encabezado del registro y habilita todos los eventos.
+ * @note Se llama al comienzo del arranque, antes del primer cambio de frecuencia.
+ */
+void TraceInit(void);
+
+/**
+ * @brief Agrega un evento al buffer circular, pisando el más viejo cuando está lleno.
+ * @param event Evento a registrar, uno de TRACE_EVENT_*.
+ * @param arg8 Primer dato del evento.
+ * @param arg16 Segundo dato del evento.
+ * @note Cuesta unas pocas decenas de ciclos, se puede llamar desde cualquier tarea o interrupción y desde las macros
+ *       de traza del sistema operativo. Antes de TraceInit la máscara vale cero y no se registra nada, el contador
+ *       de ciclos lo habilita MonitorTimerInit.
+ */
+void TraceRecord(uint8_t event, uint8_t arg8, uint16_t arg16);
+
+/**
+ * @brief Registra la frecuencia del núcleo, que el decodificador usa para convertir ciclos en tiempo.
+ * @param hz Nueva frecuencia del núcleo.
+ */
+void TraceClock(uint32_t hz);
+
+/**
+ * @brief Elige los eventos que se registran.
+ * @param mask Un bit por evento, (1 << TRACE_EVENT_*), TRACE_ALL_EVENTS para todos.
+ */
+void TraceSetMask(uint32_t mask);
+
+/**
+ * @brief Obtiene el buffer circular para volcarlo.
+ * @return Puntero al registro completo, con su encabezado.
+ */
+const trace_log_t * TraceGetLog(void);
+
+/* === End of conditional blocks =================================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRACE_H_ */
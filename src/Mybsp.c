@@ -25,135 +25,471 @@ SPDX-License-Identifier: MIT
 
 #include "Mybsp.h"
 #include "CIAA.h"
+#include "FreeRTOS.h"
+#include "buzzer.h"
 #include "chip.h"
 #include "poncho.h"
+#include "power.h"
+#include "ramfunc.h"
+#include "spi_display.h"
+#include "sync.h"
 #include <stddef.h>
 #include <stdlib.h>
+#include <string.h>
 
 /* === Macros definitions ========================================================================================== */
 
+#define DIM_TIMER       LPC_TIMER2    // Temporizador que apaga los dígitos para controlar el brillo
+#define DIM_TIMER_CLK   CLK_MX_TIMER2 // Reloj del temporizador de brillo
+#define DIM_TIMER_IRQ   TIMER2_IRQn   // Interrupción del temporizador de brillo
+#define DIM_TIMER_MATCH 0             // Canal de comparación usado para el apagado
+#define DIM_SLOT_US     1000          // Duración del intervalo de refresco de un dígito en microsegundos
+
+#define BOARD_DIGITS (sizeof(DIGITS_MAP) / sizeof(DIGITS_MAP[0])) // Cantidad de dígitos de la pantalla
+
+#ifndef BOARD_SPI_DISPLAY_DIGITS
+#define BOARD_SPI_DISPLAY_DIGITS 0 // Dígitos de la pantalla serie por SSP1, con 0 se usa la pantalla del poncho
+#endif
+
+#define SPI_DISPLAY_SSP     LPC_SSP1   // Puerto SSP conectado a la cadena de registros
+#define SPI_DISPLAY_BITRATE 1000000    // Frecuencia del reloj de la cadena de registros
+
+#define CONSOLE_UART      LPC_USART2 // Puerto serie conectado al puerto de depuración USB
+#define CONSOLE_BAUDRATE  115200     // Velocidad de la consola
+#define DMA_TRANSFER_SIZE 0xFFF      // Campo de la cantidad de transferencias pendientes de un canal de DMA
+
+#define SYNC_UART     LPC_USART3 // Puerto serie conectado al receptor GPS o a la referencia de hora por RS-232
+#define SYNC_BAUDRATE 9600       // Velocidad de los receptores NMEA
+#define PPS_PININT    0          // Canal de interrupción de pin del pulso por segundo, en la terminal GPIO0
+#define PPS_IRQ       PIN_INT0_IRQn
+
+#define SETTINGS_EEPROM_SIZE ((EEPROM_PAGE_NUM - 1) * EEPROM_PAGE_SIZE) // La última página está reservada
+
+#define SEGMENTS_WRITES_PER_REFRESH 4 // Escrituras a los segmentos por refresco sin caché (apagar y encender)
+
+#define BOARD_GPIO_PORTS 8 // Cantidad de puertos GPIO del microcontrolador
+
+#define PIN_INPUT  0        // El pin es una entrada
+#define PIN_OUTPUT (1 << 0) // El pin es una salida
+#define PIN_HIGH   (1 << 1) // La salida arranca en estado alto
+
+#define PIN_MODE_OUTPUT (SCU_MODE_INBUFF_EN | SCU_MODE_INACT)   // Configuración eléctrica de las salidas
+#define PIN_MODE_KEY    (SCU_MODE_INBUFF_EN | SCU_MODE_PULLUP) // Configuración eléctrica de las teclas
+
+//! Descriptor de un pin de la placa a partir de los nombres de poncho.h o CIAA.h
+#define BOARD_PIN(name, mode, flags)                                                                                   \
+    {name##_PORT, name##_PIN, (mode) | name##_FUNC, name##_GPIO, name##_BIT, flags}
+
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof(a[0]))
+
 /* === Private data type declarations ============================================================================== */
 
+//! Configuración de un pin de la placa
+typedef struct board_pin_s {
+    uint8_t port;  /**< Puerto del pin en el SCU */
+    uint8_t pin;   /**< Número de pin dentro del puerto del SCU */
+    uint16_t mode; /**< Función y configuración eléctrica del pin */
+    uint8_t gpio;  /**< Puerto GPIO asociado */
+    uint8_t bit;   /**< Bit dentro del puerto GPIO */
+    uint8_t flags; /**< Dirección y estado inicial, PIN_OUTPUT y PIN_HIGH */
+} board_pin_t;
+
 /* === Private function declarations =============================================================================== */
 
-void DigitsTurnOff(void) {
+#if BOARD_SPI_DISPLAY_DIGITS == 0
+//! Pin de selección de cada dígito de la pantalla, de izquierda a derecha
+__ramdata static const uint32_t DIGITS_MAP[] = {DIGIT_4_MASK, DIGIT_3_MASK, DIGIT_2_MASK, DIGIT_1_MASK};
+
+static uint8_t segments_state = 0; /**< Último valor escrito en los segmentos, igual al estado de los pines */
+#endif
+
+static struct board_screen_writes_s screen_writes = {0}; /**< Contadores de escrituras a los segmentos */
+
+static struct board_s * board_instance = NULL; /**< Placa creada, completada luego por BoardCreatePeripherals */
+
+static uint8_t console_rx[CONSOLE_RX_SIZE]; /**< Buffer circular que el DMA llena con lo recibido por la consola */
+
+static DMA_TransferDescriptor_t console_rx_descriptor; /**< Descriptor que se enlaza a sí mismo, recepción continua */
+
+static uint8_t console_rx_channel; /**< Canal de DMA de la recepción de la consola */
+
+static uint8_t console_tx_channel; /**< Canal de DMA de la transmisión de la consola */
+
+static uint8_t sync_rx[SYNC_RX_SIZE]; /**< Buffer circular que el DMA llena con lo recibido de la referencia */
+
+static DMA_TransferDescriptor_t sync_rx_descriptor; /**< Descriptor que se enlaza a sí mismo, recepción continua */
+
+static uint8_t sync_rx_channel; /**< Canal de DMA de la recepción de la referencia */
+
+#if BOARD_SPI_DISPLAY_DIGITS == 0
+//! Pines de la pantalla multiplexada, todos salidas en estado bajo
+static const board_pin_t SCREEN_PINS[] = {
+    BOARD_PIN(DIGIT_1, PIN_MODE_OUTPUT, PIN_OUTPUT),   BOARD_PIN(DIGIT_2, PIN_MODE_OUTPUT, PIN_OUTPUT),
+    BOARD_PIN(DIGIT_3, PIN_MODE_OUTPUT, PIN_OUTPUT),   BOARD_PIN(DIGIT_4, PIN_MODE_OUTPUT, PIN_OUTPUT),
+    BOARD_PIN(SEGMENT_A, PIN_MODE_OUTPUT, PIN_OUTPUT), BOARD_PIN(SEGMENT_B, PIN_MODE_OUTPUT, PIN_OUTPUT),
+    BOARD_PIN(SEGMENT_C, PIN_MODE_OUTPUT, PIN_OUTPUT), BOARD_PIN(SEGMENT_D, PIN_MODE_OUTPUT, PIN_OUTPUT),
+    BOARD_PIN(SEGMENT_E, PIN_MODE_OUTPUT, PIN_OUTPUT), BOARD_PIN(SEGMENT_F, PIN_MODE_OUTPUT, PIN_OUTPUT),
+    BOARD_PIN(SEGMENT_G, PIN_MODE_OUTPUT, PIN_OUTPUT), BOARD_PIN(SEGMENT_P, PIN_MODE_OUTPUT, PIN_OUTPUT),
+};
+#endif
+
+//! Pines de LEDs, zumbador y teclas
+static const board_pin_t PERIPHERAL_PINS[] = {
+    // Los LEDs rojo y verde se conectan en los pines de la placa pero se manejan con los GPIO del poncho. El rojo
+    // del poncho está en P1_4, el MOSI de SSP1, y con la pantalla serie ese pin pertenece al puerto
+#if BOARD_SPI_DISPLAY_DIGITS == 0
+    {LED_R_PORT, LED_R_PIN, PIN_MODE_OUTPUT | LED_R_FUNC, SHIELD_RGB_RED_GPIO, SHIELD_RGB_RED_BIT, PIN_OUTPUT},
+#endif
+    {LED_G_PORT, LED_G_PIN, PIN_MODE_OUTPUT | LED_G_FUNC, SHIELD_RGB_GREEN_GPIO, SHIELD_RGB_GREEN_BIT,
+     PIN_OUTPUT | PIN_HIGH},
+    // El LED azul de la placa comparte el pin P2_2 con el zumbador, se configura el del poncho
+    BOARD_PIN(SHIELD_RGB_BLUE, PIN_MODE_OUTPUT, PIN_OUTPUT | PIN_HIGH),
+    BOARD_PIN(BUZZER, PIN_MODE_OUTPUT, PIN_OUTPUT),
+    BOARD_PIN(KEY_F1, PIN_MODE_KEY, PIN_INPUT),
+    BOARD_PIN(KEY_F2, PIN_MODE_KEY, PIN_INPUT),
+    BOARD_PIN(KEY_F3, PIN_MODE_KEY, PIN_INPUT),
+    BOARD_PIN(KEY_F4, PIN_MODE_KEY, PIN_INPUT),
+    BOARD_PIN(KEY_ACCEPT, PIN_MODE_KEY, PIN_INPUT),
+    BOARD_PIN(KEY_CANCEL, PIN_MODE_KEY, PIN_INPUT),
+};
+
+#if BOARD_SPI_DISPLAY_DIGITS == 0
+__ramfunc void DigitsTurnOff(void) {
+    // Los segmentos no se apagan, SegmentsUpdate escribe solamente los que cambian con los dígitos apagados
     Chip_GPIO_ClearValue(LPC_GPIO_PORT, DIGITS_GPIO, DIGITS_MASK);
-    Chip_GPIO_ClearValue(LPC_GPIO_PORT, SEGMENTS_GPIO, SEGMENTS_MASK);
-    Chip_GPIO_SetPinState(LPC_GPIO_PORT, SEGMENT_P_GPIO, SEGMENT_P_BIT, false); // Apagar el punto decimal
 }
 
-void SegmentsUpdate(uint8_t value) {
-    Chip_GPIO_SetValue(LPC_GPIO_PORT, SEGMENTS_GPIO, (value & SEGMENTS_MASK));
-    Chip_GPIO_SetPinState(LPC_GPIO_PORT, SEGMENT_P_GPIO, SEGMENT_P_BIT, (value & SEGMENT_P));
+__ramfunc void SegmentsUpdate(uint8_t value) {
+    uint8_t changed = value ^ segments_state;
+    uint32_t issued = 0;
+
+    if (changed & value & SEGMENTS_MASK) {
+        Chip_GPIO_SetValue(LPC_GPIO_PORT, SEGMENTS_GPIO, (changed & value & SEGMENTS_MASK));
+        issued++;
+    }
+    if (changed & ~value & SEGMENTS_MASK) {
+        Chip_GPIO_ClearValue(LPC_GPIO_PORT, SEGMENTS_GPIO, (changed & ~value & SEGMENTS_MASK));
+        issued++;
+    }
+    if (changed & SEGMENT_P) {
+        Chip_GPIO_SetPinState(LPC_GPIO_PORT, SEGMENT_P_GPIO, SEGMENT_P_BIT, (value & SEGMENT_P));
+        issued++;
+    }
+
+    segments_state = value;
+    screen_writes.issued += issued;
+    screen_writes.skipped += SEGMENTS_WRITES_PER_REFRESH - issued;
+}
+
+__ramfunc void DigitTurnOn(uint8_t digit) {
+    Chip_GPIO_SetValue(LPC_GPIO_PORT, DIGITS_GPIO, DIGITS_MAP[digit]);
+}
+
+__ramfunc void DigitDim(uint8_t duty) {
+    // Chip_TIMER_Reset está en la flash; con el contador detenido alcanza con escribir los registros de cuenta
+    Chip_TIMER_Disable(DIM_TIMER);
+    DIM_TIMER->TC = 0;
+    DIM_TIMER->PC = 0;
+    Chip_TIMER_SetMatch(DIM_TIMER, DIM_TIMER_MATCH, ((uint32_t)duty * DIM_SLOT_US) >> 8);
+    Chip_TIMER_Enable(DIM_TIMER); /**< Se detiene solo al llegar a la comparación */
 }
 
-void DigitTurnOn(uint8_t digit) {
-    Chip_GPIO_SetValue(LPC_GPIO_PORT, DIGITS_GPIO, (1 << (3 - digit)) & DIGITS_MASK);
+__ramfunc void TIMER2_IRQHandler(void) {
+    Chip_TIMER_ClearMatch(DIM_TIMER, DIM_TIMER_MATCH);
+    Chip_GPIO_ClearValue(LPC_GPIO_PORT, DIGITS_GPIO, DIGITS_MASK); /**< Fin del tiempo de encendido del dígito */
+}
+#else
+void SpiDisplaySend(const uint8_t * frame, uint8_t size) {
+    static uint8_t channel = 0xFF;
+
+    if (channel == 0xFF) {
+        channel = Chip_GPDMA_GetFreeChannel(LPC_GPDMA, GPDMA_CONN_SSP1_Tx);
+    }
+    // El SSEL se mantiene bajo mientras la FIFO tenga datos y su flanco de subida carga los registros
+    Chip_GPDMA_Transfer(LPC_GPDMA, channel, (uint32_t)frame, GPDMA_CONN_SSP1_Tx, GPDMA_TRANSFERTYPE_M2P_CONTROLLER_DMA,
+                        size);
+}
+#endif
+
+static void EepromClockChanged(void) {
+    // El divisor de 1,5 MHz y los estados de espera se calculan con el reloj del núcleo; a 51 MHz los valores de
+    // 204 MHz programarían cuatro veces más lento. Nunca coincide con una programación, EepromWrite mantiene el modo
+    Chip_EEPROM_Init(LPC_EEPROM);
+}
+
+void EepromRead(uint32_t offset, void * data, uint32_t size) {
+    memcpy(data, (const void *)(EEPROM_START + offset), size); /**< La EEPROM se lee como memoria */
+}
+
+bool EepromWrite(uint32_t offset, const void * data, uint32_t size) {
+    static uint32_t page[EEPROM_PAGE_SIZE / sizeof(uint32_t)];
+    volatile uint32_t * address = (volatile uint32_t *)(EEPROM_START + offset - (offset % EEPROM_PAGE_SIZE));
+    uint32_t index;
+
+    if ((offset % EEPROM_PAGE_SIZE) + size > EEPROM_PAGE_SIZE) {
+        return false; /**< La escritura no puede cruzar el límite de una página */
+    }
+    // Se carga la página completa en el registro de página, con los datos nuevos sobre los actuales
+    for (index = 0; index < EEPROM_PAGE_SIZE / sizeof(uint32_t); index++) {
+        page[index] = address[index];
+    }
+    memcpy((uint8_t *)page + (offset % EEPROM_PAGE_SIZE), data, size);
+    // Los tiempos de programación dependen del reloj del núcleo, que no puede cambiar hasta que la página termine
+    PowerHoldMode();
+    for (index = 0; index < EEPROM_PAGE_SIZE / sizeof(uint32_t); index++) {
+        address[index] = page[index];
+    }
+    Chip_EEPROM_EraseProgramPage(LPC_EEPROM);
+    Chip_EEPROM_WaitForIntStatus(LPC_EEPROM, EEPROM_INT_ENDOFPROG);
+    PowerReleaseMode();
+    return true;
+}
+
+uint16_t ConsoleRxPosition(void) {
+    // El canal cuenta hacia abajo las transferencias que faltan para el final del buffer
+    return CONSOLE_RX_SIZE - (LPC_GPDMA->CH[console_rx_channel].CONTROL & DMA_TRANSFER_SIZE);
+}
+
+void ConsoleTxStart(const uint8_t * data, uint16_t size) {
+    Chip_GPDMA_Transfer(LPC_GPDMA, console_tx_channel, (uint32_t)data, GPDMA_CONN_UART2_Tx,
+                        GPDMA_TRANSFERTYPE_M2P_CONTROLLER_DMA, size);
+}
+
+bool ConsoleTxBusy(void) {
+    return Chip_GPDMA_IntGetStatus(LPC_GPDMA, GPDMA_STAT_ENABLED_CH, console_tx_channel) == SET;
+}
+
+uint16_t SyncRxPosition(void) {
+    return SYNC_RX_SIZE - (LPC_GPDMA->CH[sync_rx_channel].CONTROL & DMA_TRANSFER_SIZE);
+}
+
+void GPIO0_IRQHandler(void) {
+    Chip_PININT_ClearIntStatus(LPC_GPIO_PIN_INT, PININTCH(PPS_PININT));
+    SyncPulse(); /**< Solo guarda el instante, la tarea de sincronización aplica la corrección */
 }
 
 /* === Private variable definitions ================================================================================ */
 
+#if BOARD_SPI_DISPLAY_DIGITS == 0
 static const struct screen_driver_s screen_driver = {
     .DigitsTurnOff = DigitsTurnOff,   // Función para apagar todos los dígitos
     .SegmentsUpdate = SegmentsUpdate, // Función para actualizar los segmentos
-    .DigitTurnOn = DigitTurnOn        // Función para encender un dígito específico
+    .DigitTurnOn = DigitTurnOn,       // Función para encender un dígito específico
+    .DigitDim = DigitDim              // Función para apagar el dígito antes de terminar el intervalo
 };
+#endif
 
-/* === Public variable definitions ================================================================================= */
+static const struct console_port_s console_port = {
+    .rx_buffer = console_rx,         // Buffer circular de recepción
+    .RxPosition = ConsoleRxPosition, // Función que obtiene la posición de escritura del DMA
+    .TxStart = ConsoleTxStart,       // Función que envía un bloque por DMA
+    .TxBusy = ConsoleTxBusy          // Función que indica si el DMA sigue enviando
+};
 
-/* === Private function definitions ================================================================================ */
+static const struct sync_port_s sync_port = {
+    .rx_buffer = sync_rx,        // Buffer circular de recepción
+    .RxPosition = SyncRxPosition // Función que obtiene la posición de escritura del DMA
+};
 
-void DigitalInit(void) {
-    Chip_SCU_PinMuxSet(DIGIT_1_PORT, DIGIT_1_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_INACT | DIGIT_1_FUNC);
-    Chip_GPIO_SetPinState(LPC_GPIO_PORT, DIGIT_1_GPIO, DIGIT_1_BIT, false); // Inicializar el pin en estado bajo
-    Chip_GPIO_SetPinDIR(LPC_GPIO_PORT, DIGIT_1_GPIO, DIGIT_1_BIT, true);
+static const struct settings_storage_s eeprom_storage = {
+    .size = SETTINGS_EEPROM_SIZE, // Zona de la EEPROM reservada para la configuración
+    .Read = EepromRead,           // Función para leer de la EEPROM
+    .Write = EepromWrite          // Función para programar una página de la EEPROM
+};
+
+/* === Public variable definitions ================================================================================= */
 
-    Chip_SCU_PinMuxSet(DIGIT_2_PORT, DIGIT_2_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_INACT | DIGIT_2_FUNC);
-    Chip_GPIO_SetPinState(LPC_GPIO_PORT, DIGIT_2_GPIO, DIGIT_2_BIT, false); // Inicializar el pin en estado bajo
-    Chip_GPIO_SetPinDIR(LPC_GPIO_PORT, DIGIT_2_GPIO, DIGIT_2_BIT, true);
+/* === Private function definitions ================================================================================ */
 
-    Chip_SCU_PinMuxSet(DIGIT_3_PORT, DIGIT_3_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_INACT | DIGIT_3_FUNC);
-    Chip_GPIO_SetPinState(LPC_GPIO_PORT, DIGIT_3_GPIO, DIGIT_3_BIT, false); // Inicializar el pin en estado bajo
-    Chip_GPIO_SetPinDIR(LPC_GPIO_PORT, DIGIT_3_GPIO, DIGIT_3_BIT, true);
+static void PinsInit(const board_pin_t pins[], uint8_t count) {
+    uint32_t outputs[BOARD_GPIO_PORTS] = {0};
+    uint32_t inputs[BOARD_GPIO_PORTS] = {0};
+    uint32_t high[BOARD_GPIO_PORTS] = {0};
+    uint8_t index;
+
+    for (index = 0; index < count; index++) {
+        const board_pin_t * pin = &pins[index];
+
+        Chip_SCU_PinMuxSet(pin->port, pin->pin, pin->mode);
+        if (pin->flags & PIN_OUTPUT) {
+            outputs[pin->gpio] |= 1UL << pin->bit;
+            if (pin->flags & PIN_HIGH) {
+                high[pin->gpio] |= 1UL << pin->bit;
+            }
+        } else {
+            inputs[pin->gpio] |= 1UL << pin->bit;
+        }
+    }
 
-    Chip_SCU_PinMuxSet(DIGIT_4_PORT, DIGIT_4_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_INACT | DIGIT_4_FUNC);
-    Chip_GPIO_SetPinState(LPC_GPIO_PORT, DIGIT_4_GPIO, DIGIT_4_BIT, false); // Inicializar el pin en estado bajo
-    Chip_GPIO_SetPinDIR(LPC_GPIO_PORT, DIGIT_4_GPIO, DIGIT_4_BIT, true);
+    // Una escritura de estado y una de dirección por puerto, con los niveles fijados antes de habilitar las salidas
+    for (index = 0; index < BOARD_GPIO_PORTS; index++) {
+        if (outputs[index] != 0) {
+            Chip_GPIO_ClearValue(LPC_GPIO_PORT, index, outputs[index] & ~high[index]);
+            Chip_GPIO_SetValue(LPC_GPIO_PORT, index, high[index]);
+            Chip_GPIO_SetPortDIROutput(LPC_GPIO_PORT, index, outputs[index]);
+        }
+        if (inputs[index] != 0) {
+            Chip_GPIO_SetPortDIRInput(LPC_GPIO_PORT, index, inputs[index]);
+        }
+    }
 }
 
-void SegmentsInit(void) {
-    Chip_SCU_PinMuxSet(SEGMENT_A_PORT, SEGMENT_A_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_INACT | SEGMENT_A_FUNC);
-    Chip_GPIO_SetPinState(LPC_GPIO_PORT, SEGMENT_A_GPIO, SEGMENT_A_BIT, false); // Inicializar el pin en estado bajo
-    Chip_GPIO_SetPinDIR(LPC_GPIO_PORT, SEGMENT_A_GPIO, SEGMENT_A_BIT, true);
+#if BOARD_SPI_DISPLAY_DIGITS == 0
+static void DimTimerClockChanged(void) {
+    PowerTimerSetRate(DIM_TIMER, DIM_TIMER_CLK, 1000000);
+}
 
-    Chip_SCU_PinMuxSet(SEGMENT_B_PORT, SEGMENT_B_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_INACT | SEGMENT_B_FUNC);
-    Chip_GPIO_SetPinState(LPC_GPIO_PORT, SEGMENT_B_GPIO, SEGMENT_B_BIT, false); // Inicializar el pin en estado bajo
-    Chip_GPIO_SetPinDIR(LPC_GPIO_PORT, SEGMENT_B_GPIO, SEGMENT_B_BIT, true);
+void DimTimerInit(void) {
+    int result;
+
+    Chip_TIMER_Init(DIM_TIMER);
+    Chip_TIMER_PrescaleSet(DIM_TIMER, Chip_Clock_GetRate(DIM_TIMER_CLK) / 1000000 - 1); /**< Cuenta en microsegundos */
+    Chip_TIMER_Reset(DIM_TIMER);
+    Chip_TIMER_MatchEnableInt(DIM_TIMER, DIM_TIMER_MATCH);
+    Chip_TIMER_StopOnMatchEnable(DIM_TIMER, DIM_TIMER_MATCH);
+    NVIC_ClearPendingIRQ(DIM_TIMER_IRQ);
+    NVIC_EnableIRQ(DIM_TIMER_IRQ);
+    result = PowerAddClockHook(DimTimerClockChanged); /**< Seguir contando en microsegundos en todos los modos */
+    configASSERT(result == 0);
+    (void)result;
+}
+#else
+void SpiDisplayInit(void) {
+    Chip_SCU_PinMuxSet(SPI_MOSI_PORT, SPI_MOSI_PIN, SCU_MODE_INACT | SPI_MOSI_FUNC);
+    Chip_SCU_PinMuxSet(SPI_SCK_PORT, SPI_SCK_PIN, SCU_MODE_INACT | SPI_SCK_FUNC);
+    Chip_SCU_PinMuxSet(SPI_SSEL_PORT, SPI_SSEL_PIN, SCU_MODE_INACT | SPI_SSEL_FUNC);
+
+    Chip_SSP_Init(SPI_DISPLAY_SSP);
+    Chip_SSP_SetFormat(SPI_DISPLAY_SSP, SSP_BITS_8, SSP_FRAMEFORMAT_SPI, SSP_CLOCK_MODE3); /**< Muestreo en subida */
+    Chip_SSP_SetMaster(SPI_DISPLAY_SSP, true);
+    Chip_SSP_SetBitRate(SPI_DISPLAY_SSP, SPI_DISPLAY_BITRATE);
+    Chip_SSP_DMA_Enable(SPI_DISPLAY_SSP);
+    Chip_SSP_Enable(SPI_DISPLAY_SSP);
+}
+#endif
+
+static uint8_t SerialPortInit(LPC_USART_T * uart, uint32_t baudrate, uint32_t connection, uint8_t * buffer,
+                              uint16_t size, DMA_TransferDescriptor_t * descriptor) {
+    uint8_t channel;
+
+    // El reloj base del puerto no depende del modo de consumo, la velocidad se mantiene al bajar la frecuencia
+    Chip_UART_Init(uart);
+    Chip_UART_SetBaud(uart, baudrate);
+    Chip_UART_ConfigData(uart, UART_LCR_WLEN8 | UART_LCR_SBS_1BIT | UART_LCR_PARITY_DIS);
+    Chip_UART_SetupFIFOS(uart, UART_FCR_FIFO_EN | UART_FCR_RX_RS | UART_FCR_TX_RS | UART_FCR_DMAMODE_SEL |
+                                   UART_FCR_TRG_LEV0);
+    Chip_UART_TXEnable(uart);
+
+    // Recepción continua en el buffer circular, sin interrupciones
+    channel = Chip_GPDMA_GetFreeChannel(LPC_GPDMA, connection);
+    Chip_GPDMA_InitDescriptor(LPC_GPDMA, descriptor, connection, (uint32_t)buffer, size,
+                              GPDMA_TRANSFERTYPE_P2M_CONTROLLER_DMA, descriptor);
+    Chip_GPDMA_SGTransfer(LPC_GPDMA, channel, descriptor, GPDMA_TRANSFERTYPE_P2M_CONTROLLER_DMA);
+    return channel;
+}
 
-    Chip_SCU_PinMuxSet(SEGMENT_C_PORT, SEGMENT_C_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_INACT | SEGMENT_C_FUNC);
-    Chip_GPIO_SetPinState(LPC_GPIO_PORT, SEGMENT_C_GPIO, SEGMENT_C_BIT, false); // Inicializar el pin en estado bajo
-    Chip_GPIO_SetPinDIR(LPC_GPIO_PORT, SEGMENT_C_GPIO, SEGMENT_C_BIT, true);
+void ConsolePortInit(void) {
+    Chip_SCU_PinMuxSet(UART_TXD_PORT, UART_TXD_PIN, SCU_MODE_INACT | UART_TXD_FUNC);
+    Chip_SCU_PinMuxSet(UART_RXD_PORT, UART_RXD_PIN,
+                       SCU_MODE_INACT | SCU_MODE_INBUFF_EN | SCU_MODE_ZIF_DIS | UART_RXD_FUNC);
 
-    Chip_SCU_PinMuxSet(SEGMENT_D_PORT, SEGMENT_D_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_INACT | SEGMENT_D_FUNC);
-    Chip_GPIO_SetPinState(LPC_GPIO_PORT, SEGMENT_D_GPIO, SEGMENT_D_BIT, false); // Inicializar el pin en estado bajo
-    Chip_GPIO_SetPinDIR(LPC_GPIO_PORT, SEGMENT_D_GPIO, SEGMENT_D_BIT, true);
+    console_rx_channel = SerialPortInit(CONSOLE_UART, CONSOLE_BAUDRATE, GPDMA_CONN_UART2_Rx, console_rx,
+                                        sizeof(console_rx), &console_rx_descriptor);
+    console_tx_channel = Chip_GPDMA_GetFreeChannel(LPC_GPDMA, GPDMA_CONN_UART2_Tx);
+}
 
-    Chip_SCU_PinMuxSet(SEGMENT_E_PORT, SEGMENT_E_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_INACT | SEGMENT_E_FUNC);
-    Chip_GPIO_SetPinState(LPC_GPIO_PORT, SEGMENT_E_GPIO, SEGMENT_E_BIT, false); // Inicializar el pin en estado bajo
-    Chip_GPIO_SetPinDIR(LPC_GPIO_PORT, SEGMENT_E_GPIO, SEGMENT_E_BIT, true);
+void SyncPortInit(void) {
+    Chip_SCU_PinMuxSet(RS232_TXD_PORT, RS232_TXD_PIN, SCU_MODE_INACT | RS232_TXD_FUNC);
+    Chip_SCU_PinMuxSet(RS232_RXD_PORT, RS232_RXD_PIN,
+                       SCU_MODE_INACT | SCU_MODE_INBUFF_EN | SCU_MODE_ZIF_DIS | RS232_RXD_FUNC);
+    sync_rx_channel =
+        SerialPortInit(SYNC_UART, SYNC_BAUDRATE, GPDMA_CONN_UART3_Rx, sync_rx, sizeof(sync_rx), &sync_rx_descriptor);
+
+    // Pulso por segundo en flanco ascendente, el comienzo de cada segundo en los receptores GPS
+    Chip_SCU_PinMuxSet(GPIO_0_PORT, GPIO_0_PIN, SCU_MODE_INACT | SCU_MODE_INBUFF_EN | GPIO_0_FUNC);
+    Chip_GPIO_SetPinDIRInput(LPC_GPIO_PORT, GPIO_0_GPIO, GPIO_0_BIT);
+    Chip_SCU_GPIOIntPinSel(PPS_PININT, GPIO_0_GPIO, GPIO_0_BIT);
+    Chip_PININT_SetPinModeEdge(LPC_GPIO_PIN_INT, PININTCH(PPS_PININT));
+    Chip_PININT_EnableIntHigh(LPC_GPIO_PIN_INT, PININTCH(PPS_PININT));
+    Chip_PININT_ClearIntStatus(LPC_GPIO_PIN_INT, PININTCH(PPS_PININT));
+    NVIC_ClearPendingIRQ(PPS_IRQ);
+    NVIC_EnableIRQ(PPS_IRQ);
+}
 
-    Chip_SCU_PinMuxSet(SEGMENT_F_PORT, SEGMENT_F_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_INACT | SEGMENT_F_FUNC);
-    Chip_GPIO_SetPinState(LPC_GPIO_PORT, SEGMENT_F_GPIO, SEGMENT_F_BIT, false); // Inicializar el pin en estado bajo
-    Chip_GPIO_SetPinDIR(LPC_GPIO_PORT, SEGMENT_F_GPIO, SEGMENT_F_BIT, true);
+/* === Public function definitions ================================================================================= */
 
-    Chip_SCU_PinMuxSet(SEGMENT_G_PORT, SEGMENT_G_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_INACT | SEGMENT_G_FUNC);
-    Chip_GPIO_SetPinState(LPC_GPIO_PORT, SEGMENT_G_GPIO, SEGMENT_G_BIT, false); // Inicializar el pin en estado bajo
-    Chip_GPIO_SetPinDIR(LPC_GPIO_PORT, SEGMENT_G_GPIO, SEGMENT_G_BIT, true);
+board_t BoardCreate(void) {
+    struct board_s * board = calloc(1, sizeof(struct board_s));
+    int result;
 
-    Chip_SCU_PinMuxSet(SEGMENT_P_PORT, SEGMENT_P_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_INACT | SEGMENT_P_FUNC);
-    Chip_GPIO_SetPinState(LPC_GPIO_PORT, SEGMENT_P_GPIO, SEGMENT_P_BIT, false); // Inicializar el pin en estado bajo
-    Chip_GPIO_SetPinDIR(LPC_GPIO_PORT, SEGMENT_P_GPIO, SEGMENT_P_BIT, true);
+    if (board != NULL) {
+        Chip_GPDMA_Init(LPC_GPDMA); // Una sola vez, los canales se reparten entre pantalla, zumbador y puertos
+
+#if BOARD_SPI_DISPLAY_DIGITS > 0
+        SpiDisplayInit(); // Inicializar el puerto serie de la pantalla
+        board->screen =
+            ScreenCreate(BOARD_SPI_DISPLAY_DIGITS, SpiDisplayCreate(BOARD_SPI_DISPLAY_DIGITS, SpiDisplaySend));
+#else
+        PinsInit(SCREEN_PINS, ARRAY_SIZE(SCREEN_PINS)); // Inicializar pines de dígitos y segmentos
+        DimTimerInit();                                  // Inicializar temporizador de brillo
+        board->screen = ScreenCreate(BOARD_DIGITS, &screen_driver);
+#endif
+
+        // Inicializar memoria de configuración
+        Chip_EEPROM_Init(LPC_EEPROM);
+        result = PowerAddClockHook(EepromClockChanged); /**< Mantener los tiempos de programación en todos los modos */
+        configASSERT(result == 0);
+        (void)result;
+        board->settings = &eeprom_storage;
+        board_instance = board;
+    }
+    return board;
 }
 
-/* === Public function definitions ================================================================================= */
+void BoardCreatePeripherals(void) {
+    struct board_s * board = board_instance;
 
-board_t BoardCreate(void) {
-    struct board_s * board = malloc(sizeof(struct board_s));
     if (board != NULL) {
-        DigitalInit();  // Inicializar pines de dígitos
-        SegmentsInit(); // Inicializar pines de segmentos
-        board->screen = ScreenCreate(4, &screen_driver);
+        PinsInit(PERIPHERAL_PINS, ARRAY_SIZE(PERIPHERAL_PINS));
 
         // Inicializar LEDs
-        Chip_SCU_PinMuxSet(LED_R_PORT, LED_R_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_INACT | LED_R_FUNC);
+#if BOARD_SPI_DISPLAY_DIGITS == 0
         board->led_R = DigitalOutputCreate(SHIELD_RGB_RED_GPIO, SHIELD_RGB_RED_BIT, false);
-
-        Chip_SCU_PinMuxSet(LED_G_PORT, LED_G_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_INACT | LED_G_FUNC);
+#else
+        board->led_R = NULL; /**< Su pin es el MOSI de la pantalla serie, la alarma se indica solo con el zumbador */
+#endif
         board->led_G = DigitalOutputCreate(SHIELD_RGB_GREEN_GPIO, SHIELD_RGB_GREEN_BIT, true);
-
-        Chip_SCU_PinMuxSet(LED_B_PORT, LED_B_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_INACT | LED_B_FUNC);
         board->led_B = DigitalOutputCreate(SHIELD_RGB_BLUE_GPIO, SHIELD_RGB_BLUE_BIT, true);
 
+        // Inicializar zumbador
+        board->buzzer = DigitalOutputCreate(BUZZER_GPIO, BUZZER_BIT, false);
+        BuzzerInit(BUZZER_GPIO, BUZZER_BIT);
+
         // Inicializar entradas digitales
-        Chip_SCU_PinMuxSet(KEY_F1_PORT, KEY_F1_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_PULLUP | KEY_F1_FUNC);
         board->set_time = DigitalInputCreate(KEY_F1_GPIO, KEY_F1_BIT, false);
-
-        Chip_SCU_PinMuxSet(KEY_F2_PORT, KEY_F2_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_PULLUP | KEY_F2_FUNC);
         board->set_alarm = DigitalInputCreate(KEY_F2_GPIO, KEY_F2_BIT, false);
-
-        Chip_SCU_PinMuxSet(KEY_F3_PORT, KEY_F3_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_PULLUP | KEY_F3_FUNC);
         board->decrement = DigitalInputCreate(KEY_F3_GPIO, KEY_F3_BIT, false);
-
-        Chip_SCU_PinMuxSet(KEY_F4_PORT, KEY_F4_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_PULLUP | KEY_F4_FUNC);
         board->increment = DigitalInputCreate(KEY_F4_GPIO, KEY_F4_BIT, false);
-
-        Chip_SCU_PinMuxSet(KEY_ACCEPT_PORT, KEY_ACCEPT_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_PULLUP | KEY_ACCEPT_FUNC);
         board->accept = DigitalInputCreate(KEY_ACCEPT_GPIO, KEY_ACCEPT_BIT, false);
-
-        Chip_SCU_PinMuxSet(KEY_CANCEL_PORT, KEY_CANCEL_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_PULLUP | KEY_CANCEL_FUNC);
         board->cancel = DigitalInputCreate(KEY_CANCEL_GPIO, KEY_CANCEL_BIT, false);
+
+        // El orden del grupo es el de los bits de las máscaras que devuelve DigitalGroupRead
+        const digital_input_t keys[] = {board->accept,    board->cancel,   board->increment,
+                                        board->decrement, board->set_time, board->set_alarm};
+        board->keys = DigitalGroupCreate(keys, ARRAY_SIZE(keys));
+
+        // Inicializar consola, con prioridad de DMA menor que la de la pantalla serie
+        ConsolePortInit();
+        board->console = &console_port;
+
+        // Inicializar la referencia de hora, el mensaje por RS-232 y el pulso por la terminal GPIO0
+        SyncPortInit();
+        board->sync = &sync_port;
     }
-    return board;
+}
+
+void BoardGetScreenWrites(board_screen_writes_t * writes) {
+    *writes = screen_writes;
 }
 
 /* === Public function implementation ==============================================================================
@@ -0,0 +1,138 @@
+/*********************************************************************************************************************
+Copyright (c) 2025, Martín Fernando Gareca del autor <mfgareca36@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*********************************************************************************************************************/
+
+/** @file bcd.c
+ ** @brief Implementación de las conversiones de horas en BCD desempaquetado
+ **
+ ** Los seis dígitos de la hora se cargan en un entero de 64 bits, un dígito por byte, y se procesan todos juntos
+ ** con operaciones de palabra completa en lugar de recorrerlos uno por uno.
+ **/
+
+/* === Headers files inclusions ==================================================================================== */
+
+#include "bcd.h"
+#include "ramfunc.h"
+#if defined(__ARM_FEATURE_SIMD32)
+#include <arm_acle.h>
+#endif
+
+/* === Macros definitions ========================================================================================== */
+
+#define BCD_LIMITS 0x020905090509ULL // Máximo de cada dígito: 2 y 9 de las horas, 5 y 9 de minutos y segundos
+#define BCD_BIAS   0xFDF6FAF6FAF6ULL // 0xFF menos el máximo de cada dígito
+#define BCD_DIGITS 0xFFFFFFFFFFFFULL // Bytes ocupados por los seis dígitos
+#define BCD_LOW7   0x7F7F7F7F7F7FULL // Siete bits bajos de cada byte
+#define BCD_HIGH   0x808080808080ULL // Bit alto de cada byte
+#define BCD_UNITS  0x00FF00FF00FFULL // Unidades de segundos, minutos y horas, una por campo de 16 bits
+
+/* === Private data type declarations ============================================================================== */
+
+/* === Private function declarations =============================================================================== */
+
+static __raminline uint64_t Load(const clock_time_t * time);
+
+static __raminline void Store(clock_time_t * time, uint64_t digits);
+
+static __raminline uint64_t ToBinary(uint64_t digits);
+
+/* === Private variable definitions ================================================================================ */
+
+/* === Public variable definitions ================================================================================= */
+
+/* === Private function definitions ================================================================================ */
+
+// Byte a byte en lugar de memcpy, que sin optimizar es una llamada a la biblioteca en la flash
+static __raminline uint64_t Load(const clock_time_t * time) {
+    uint64_t digits = 0;
+
+    for (int index = sizeof(time->bcd) - 1; index >= 0; index--) {
+        digits = (digits << 8) | time->bcd[index]; /**< El primer dígito queda en el byte menos significativo */
+    }
+    return digits;
+}
+
+static __raminline void Store(clock_time_t * time, uint64_t digits) {
+    for (unsigned int index = 0; index < sizeof(time->bcd); index++) {
+        time->bcd[index] = (uint8_t)digits;
+        digits >>= 8;
+    }
+}
+
+//! Devuelve segundos, minutos y horas en binario, cada uno en un campo de 16 bits
+static __raminline uint64_t ToBinary(uint64_t digits) {
+    return (digits & BCD_UNITS) + ((digits >> 8) & BCD_UNITS) * 10; /**< Cada campo vale menos de 100, sin acarreo */
+}
+
+/* === Public function definitions ================================================================================= */
+
+bool BcdTimeIsValid(const clock_time_t * time) {
+    uint64_t digits = Load(time);
+    bool valid;
+
+#if defined(__ARM_FEATURE_SIMD32)
+    // La resta saturada deja en cero cada byte que no supera su máximo
+    valid = (__uqsub8((uint32_t)digits, (uint32_t)BCD_LIMITS) |
+             __uqsub8((uint32_t)(digits >> 32), (uint32_t)(BCD_LIMITS >> 32))) == 0;
+#else
+    // El bit alto de cada byte de (máximo + 0x80 - dígito) queda en uno solo si el dígito no supera el máximo
+    valid = ((((BCD_LIMITS | BCD_HIGH) - (digits & BCD_LOW7)) & ~digits & BCD_HIGH) == BCD_HIGH);
+#endif
+
+    return valid && ((ToBinary(digits) >> 32) < 24);
+}
+
+__ramfunc bool BcdTimeIncrement(clock_time_t * time) {
+    bool new_day = false;
+    uint64_t digits;
+    uint64_t wrapped;
+
+    // Con el sesgo, cada dígito en su máximo vale 0xFF y el acarreo de la suma se propaga solo por esos bytes
+    digits = ((Load(time) + BCD_BIAS + 1) & BCD_DIGITS);
+
+    // Los bytes que desbordaron quedan en cero y vuelven a cero; al resto se le quita el sesgo
+    wrapped = ~(((digits & BCD_LOW7) + BCD_LOW7) | digits) & BCD_HIGH;
+    digits -= BCD_BIAS & ~((wrapped >> 7) * 0xFF);
+
+    if ((ToBinary(digits) >> 32) == 24) {
+        digits &= 0xFFFFFFFFULL; /**< Después de 23:59:59 sigue 00:00:00 */
+        new_day = true;
+    }
+    Store(time, digits);
+    return new_day;
+}
+
+uint32_t BcdTimeToSeconds(const clock_time_t * time) {
+    uint64_t fields = ToBinary(Load(time));
+
+    return (uint32_t)(fields & 0xFFFF) + (uint32_t)((fields >> 16) & 0xFFFF) * 60 + (uint32_t)(fields >> 32) * 3600;
+}
+
+void BcdTimeFromSeconds(clock_time_t * time, uint32_t seconds) {
+    uint64_t fields;
+    uint64_t tens;
+
+    seconds %= BCD_SECONDS_PER_DAY;
+    fields = (seconds % 60) | ((uint64_t)((seconds / 60) % 60) << 16) | ((uint64_t)(seconds / 3600) << 32);
+
+    // (campo * 205) >> 11 es la división por 10 exacta para valores menores a 100, sin acarreo entre campos
+    tens = ((fields * 205) >> 11) & 0x000F000F000FULL;
+    Store(time, (fields - tens * 10) | (tens << 8));
+}
+
+/* === End of documentation ======================================================================================== */
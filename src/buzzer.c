@@ -0,0 +1,255 @@
+/*********************************************************************************************************************
+Copyright (c) 2025, Martín Fernando Gareca del autor <mfgareca36@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*********************************************************************************************************************/
+
+/** @file buzzer.c
+ ** @brief Implementación de funciones y macros para la reproducción de melodías en el zumbador
+ **/
+
+/* === Headers files inclusions ==================================================================================== */
+
+#include "buzzer.h"
+#include "FreeRTOS.h"
+#include "power.h"
+#include "chip.h"
+#include <stddef.h>
+
+/* === Macros definitions ========================================================================================== */
+
+#define BUZZER_TONE_TIMER  LPC_TIMER1    // Temporizador de tonos, sus comparaciones piden transferencias de DMA
+#define BUZZER_TONE_CLK    CLK_MX_TIMER1 // Reloj del temporizador de tonos
+#define BUZZER_TONE_HZ     1000000       // Frecuencia de cuenta del temporizador de tonos
+#define BUZZER_MATCH_CYCLE 0             // Comparación que marca el inicio de cada período, enciende el pin
+#define BUZZER_MATCH_PULSE 1             // Comparación que marca el fin del pulso, apaga el pin
+#define BUZZER_DMA_CYCLE   3             // Pedido de DMA de la comparación 0 del TIMER1, opción 0 del DMAMUX
+#define BUZZER_DMA_PULSE   4             // Pedido de DMA de la comparación 1 del TIMER1, opción 0 del DMAMUX
+#define BUZZER_NOTE_TIMER  LPC_TIMER0    // Temporizador que mide la duración de cada nota
+#define BUZZER_NOTE_CLK    CLK_MX_TIMER0 // Reloj del temporizador de notas
+#define BUZZER_NOTE_IRQ    TIMER0_IRQn   // Interrupción de fin de nota
+#define BUZZER_NOTE_HZ     1000          // El temporizador de notas cuenta milisegundos
+#define BUZZER_NOTE_MATCH  0             // Comparación que marca el fin de la nota
+#define BUZZER_IRQ_PRIO    6             // Prioridad baja para no demorar otras interrupciones
+
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof(a[0]))
+
+/* === Private data type declarations ============================================================================== */
+
+//! Etapa del sonido de alarma
+typedef struct buzzer_stage_s {
+    buzzer_melody_t melody; /**< Patrón de la etapa */
+    uint8_t volume;         /**< Volumen de la etapa */
+    uint8_t repeats;        /**< Repeticiones del patrón antes de pasar a la siguiente etapa, 0 para siempre */
+} buzzer_stage_t;
+
+//! Estado del reproductor, modificado solamente en la interrupción de fin de nota mientras suena
+struct buzzer_s {
+    uint8_t gpio;                   /**< Puerto del zumbador */
+    uint32_t mask;                  /**< Máscara del pin del zumbador, el DMA la copia en cada flanco */
+    DMA_TransferDescriptor_t cycle; /**< Descriptor que enciende el pin al comienzo de cada período */
+    DMA_TransferDescriptor_t pulse; /**< Descriptor que apaga el pin al final del pulso */
+    const buzzer_melody_t * melody; /**< Melodía en reproducción */
+    uint8_t note;                   /**< Nota en reproducción */
+    uint8_t volume;                 /**< Volumen de la melodía */
+    bool repeat;                    /**< Indica si la melodía se repite */
+    const buzzer_stage_t * stage;   /**< Etapa de alarma en reproducción, NULL fuera de la alarma */
+    uint8_t repeats;                /**< Repeticiones que faltan para terminar la etapa de alarma */
+    volatile bool playing;          /**< Indica si el zumbador está sonando */
+};
+
+/* === Private function declarations =============================================================================== */
+
+static void EdgeChannelInit(uint8_t request, volatile uint32_t * target, DMA_TransferDescriptor_t * descriptor);
+
+static void LoadNote(void);
+
+static bool NextNote(void);
+
+static void Start(const buzzer_melody_t * melody, uint8_t volume, bool repeat, const buzzer_stage_t * stage);
+
+static void ClockChanged(void);
+
+/* === Private variable definitions ================================================================================ */
+
+static const buzzer_note_t ALARM_SLOW[] = {{2000, 100}, {0, 900}};
+
+static const buzzer_note_t ALARM_DOUBLE[] = {{2000, 100}, {0, 100}, {2000, 100}, {0, 700}};
+
+static const buzzer_note_t ALARM_TRIPLE[] = {{2500, 80}, {0, 60}, {2500, 80}, {0, 60}, {2500, 80}, {0, 400}};
+
+static const buzzer_note_t ALARM_FAST[] = {{3000, 50}, {0, 50}};
+
+//! Etapas del sonido de alarma, cada una más fuerte y con un patrón más denso que la anterior
+static const buzzer_stage_t ALARM_STAGES[] = {
+    {{ALARM_SLOW, ARRAY_SIZE(ALARM_SLOW)}, 2, 10},                /**< 10 segundos de pitidos suaves */
+    {{ALARM_DOUBLE, ARRAY_SIZE(ALARM_DOUBLE)}, 4, 10},            /**< 10 segundos de pitidos dobles */
+    {{ALARM_TRIPLE, ARRAY_SIZE(ALARM_TRIPLE)}, 8, 13},            /**< 10 segundos de pitidos triples, 13 de 760 ms */
+    {{ALARM_FAST, ARRAY_SIZE(ALARM_FAST)}, BUZZER_VOLUME_MAX, 0}, /**< Pitidos rápidos a volumen máximo */
+};
+
+static struct buzzer_s self[1];
+
+/* === Public variable definitions ================================================================================= */
+
+/* === Private function definitions ================================================================================ */
+
+static void EdgeChannelInit(uint8_t request, volatile uint32_t * target, DMA_TransferDescriptor_t * descriptor) {
+    uint8_t channel = Chip_GPDMA_GetFreeChannel(LPC_GPDMA, 0);
+
+    // Una palabra por pedido, con el descriptor enlazado a sí mismo para que el canal no termine nunca
+    descriptor->src = (uint32_t)&self->mask;
+    descriptor->dst = (uint32_t)target;
+    descriptor->lli = (uint32_t)descriptor;
+    descriptor->ctrl = GPDMA_DMACCxControl_TransferSize(1) | GPDMA_DMACCxControl_SWidth(GPDMA_WIDTH_WORD) |
+                       GPDMA_DMACCxControl_DWidth(GPDMA_WIDTH_WORD);
+
+    LPC_CREG->DMAMUX &= ~(3UL << (2 * request)); /**< La opción 0 de estas líneas son las comparaciones del TIMER1 */
+    LPC_GPDMA->CH[channel].SRCADDR = descriptor->src;
+    LPC_GPDMA->CH[channel].DESTADDR = descriptor->dst;
+    LPC_GPDMA->CH[channel].LLI = descriptor->lli;
+    LPC_GPDMA->CH[channel].CONTROL = descriptor->ctrl;
+    LPC_GPDMA->CH[channel].CONFIG = GPDMA_DMACCxConfig_E | GPDMA_DMACCxConfig_DestPeripheral(request) |
+                                    GPDMA_DMACCxConfig_TransferType(GPDMA_TRANSFERTYPE_M2P_CONTROLLER_DMA);
+}
+
+static void LoadNote(void) {
+    const buzzer_note_t * note = &self->melody->notes[self->note];
+    uint32_t period;
+    uint32_t pulse;
+
+    Chip_TIMER_Disable(BUZZER_TONE_TIMER);
+    Chip_TIMER_Reset(BUZZER_TONE_TIMER);
+    Chip_GPIO_ClearValue(LPC_GPIO_PORT, self->gpio, self->mask); /**< La nota anterior pudo terminar con el pin alto */
+    if (note->frequency != 0) {
+        period = BUZZER_TONE_HZ / note->frequency;
+        pulse = (period * self->volume) / (2 * BUZZER_VOLUME_MAX);
+        Chip_TIMER_SetMatch(BUZZER_TONE_TIMER, BUZZER_MATCH_CYCLE, period - 1);
+        Chip_TIMER_SetMatch(BUZZER_TONE_TIMER, BUZZER_MATCH_PULSE, (pulse != 0) ? pulse : 1);
+        Chip_TIMER_Enable(BUZZER_TONE_TIMER); /**< Desde aquí los flancos los escribe el DMA */
+    }
+
+    Chip_TIMER_SetMatch(BUZZER_NOTE_TIMER, BUZZER_NOTE_MATCH, (note->duration_ms != 0) ? note->duration_ms : 1);
+    Chip_TIMER_Reset(BUZZER_NOTE_TIMER);
+}
+
+static bool NextNote(void) {
+    self->note++;
+    if (self->note < self->melody->count) {
+        return true;
+    }
+
+    self->note = 0;
+    if (self->stage != NULL) {
+        if (self->stage->repeats != 0) {
+            self->repeats--;
+            if (self->repeats == 0) {
+                self->stage++; /**< Pasar a la siguiente etapa de la alarma */
+                self->repeats = self->stage->repeats;
+                self->melody = &self->stage->melody;
+                self->volume = self->stage->volume;
+            }
+        }
+        return true;
+    }
+    return self->repeat;
+}
+
+static void Start(const buzzer_melody_t * melody, uint8_t volume, bool repeat, const buzzer_stage_t * stage) {
+    BuzzerStop();
+    self->melody = melody;
+    self->volume = volume;
+    self->repeat = repeat;
+    self->stage = stage;
+    self->repeats = (stage != NULL) ? stage->repeats : 0;
+    self->note = 0;
+    LoadNote();
+
+    self->playing = true;
+    Chip_TIMER_Enable(BUZZER_NOTE_TIMER);
+}
+
+static void ClockChanged(void) {
+    PowerTimerSetRate(BUZZER_TONE_TIMER, BUZZER_TONE_CLK, BUZZER_TONE_HZ);
+    PowerTimerSetRate(BUZZER_NOTE_TIMER, BUZZER_NOTE_CLK, BUZZER_NOTE_HZ);
+}
+
+/* === Public function definitions ================================================================================= */
+
+void BuzzerInit(uint8_t gpio, uint8_t bit) {
+    int result;
+
+    self->gpio = gpio;
+    self->mask = 1UL << bit;
+    self->playing = false;
+
+    // El pin del zumbador no tiene salida de comparación ni del SCT: cada comparación pide al DMA que copie la
+    // máscara en el registro de encendido o de apagado del puerto, sin interrupciones por flanco
+    Chip_TIMER_Init(BUZZER_TONE_TIMER);
+    Chip_TIMER_PrescaleSet(BUZZER_TONE_TIMER, Chip_Clock_GetRate(BUZZER_TONE_CLK) / BUZZER_TONE_HZ - 1);
+    Chip_TIMER_ResetOnMatchEnable(BUZZER_TONE_TIMER, BUZZER_MATCH_CYCLE);
+    Chip_TIMER_ClearMatch(BUZZER_TONE_TIMER, BUZZER_MATCH_CYCLE); /**< Evita un pedido de DMA inicial espurio */
+    Chip_TIMER_ClearMatch(BUZZER_TONE_TIMER, BUZZER_MATCH_PULSE);
+    EdgeChannelInit(BUZZER_DMA_CYCLE, &LPC_GPIO_PORT->SET[gpio], &self->cycle);
+    EdgeChannelInit(BUZZER_DMA_PULSE, &LPC_GPIO_PORT->CLR[gpio], &self->pulse);
+
+    // Una sola interrupción por nota, para pasar a la siguiente
+    Chip_TIMER_Init(BUZZER_NOTE_TIMER);
+    Chip_TIMER_PrescaleSet(BUZZER_NOTE_TIMER, Chip_Clock_GetRate(BUZZER_NOTE_CLK) / BUZZER_NOTE_HZ - 1);
+    Chip_TIMER_MatchEnableInt(BUZZER_NOTE_TIMER, BUZZER_NOTE_MATCH);
+    NVIC_SetPriority(BUZZER_NOTE_IRQ, BUZZER_IRQ_PRIO);
+    NVIC_ClearPendingIRQ(BUZZER_NOTE_IRQ);
+    NVIC_EnableIRQ(BUZZER_NOTE_IRQ);
+    result = PowerAddClockHook(ClockChanged); /**< Los tonos y las duraciones no cambian con el reloj del núcleo */
+    configASSERT(result == 0);
+    (void)result;
+}
+
+int BuzzerPlay(const buzzer_melody_t * melody, uint8_t volume, bool repeat) {
+    if ((melody == NULL) || (melody->count == 0) || (volume == 0) || (volume > BUZZER_VOLUME_MAX)) {
+        return -1;
+    }
+
+    Start(melody, volume, repeat, NULL);
+    return 0;
+}
+
+void BuzzerAlarmStart(void) {
+    Start(&ALARM_STAGES[0].melody, ALARM_STAGES[0].volume, true, &ALARM_STAGES[0]);
+}
+
+void BuzzerStop(void) {
+    Chip_TIMER_Disable(BUZZER_NOTE_TIMER);
+    Chip_TIMER_Disable(BUZZER_TONE_TIMER);
+    Chip_GPIO_ClearValue(LPC_GPIO_PORT, self->gpio, self->mask);
+    self->stage = NULL;
+    self->playing = false;
+}
+
+bool BuzzerIsPlaying(void) {
+    return self->playing;
+}
+
+void TIMER0_IRQHandler(void) {
+    Chip_TIMER_ClearMatch(BUZZER_NOTE_TIMER, BUZZER_NOTE_MATCH);
+    if (NextNote()) {
+        LoadNote();
+    } else {
+        BuzzerStop(); /**< Fin de una melodía sin repetición */
+    }
+}
+
+/* === End of documentation ======================================================================================== */
@@ -24,17 +24,35 @@ SPDX-License-Identifier: MIT
 /* === Headers files inclusions ==================================================================================== */
 
 #include "clock.h"
+#include "bcd.h"
+#include "ramfunc.h"
 #include <stddef.h>
 #include <string.h>
 
 /* === Macros definitions ========================================================================================== */
 
+#define CLOCK_DEFAULT_YEAR  2025 /**< Fecha inicial del reloj, 1 de enero de 2025, un miércoles */
+#define CLOCK_DEFAULT_WDAY  3
+#define CLOCK_YEAR_MIN_WDAY 1    /**< El 1 de enero de CLOCK_YEAR_MIN fue lunes */
+
 /* === Private data type declarations ============================================================================== */
 
 /* === Private function declarations =============================================================================== */
 
+static __raminline bool IsLeapYear(uint16_t year);
+
+static __raminline uint8_t DaysInMonth(uint16_t year, uint8_t month);
+
+__ramfunc static void NextDay(clock_date_t * date);
+
 /* === Private variable definitions ================================================================================ */
 
+//! Días de cada mes en un año no bisiesto
+__ramdata static const uint8_t DAYS_IN_MONTH[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+//! Desplazamiento del día de la semana al comienzo de cada mes, contando enero y febrero en el año anterior
+static const uint8_t MONTH_WEEKDAY_OFFSET[12] = {0, 3, 2, 5, 0, 3, 5, 1, 4, 6, 2, 4};
+
 /* === Public variable definitions ================================================================================= */
 
 /**
@@ -51,16 +69,61 @@ struct clock_s {
     bool alarm_valid;                /**< Indicador de validez de la alarma */
     bool alarm_ringing;              /**< Indicador de si la alarma está sonando */
     bool alarm_enabled;              /**< Indicador de si la alarma está habilitada */
+    uint8_t alarm_days;              /**< Días de la semana en los que suena la alarma, un bit por día */
+
+    clock_date_t date; /**< Fecha actual del reloj */
+    bool date_valid;   /**< Indicador de si la fecha fue establecida */
+
+    volatile bool stopwatch_running; /**< Indicador de si el cronómetro está en marcha */
+    volatile bool countdown_running; /**< Indicador de si la cuenta regresiva está en marcha */
+    uint32_t stopwatch_ms;           /**< Tiempo medido por el cronómetro */
+    uint32_t stopwatch_lap;          /**< Tiempo del cronómetro al tomar la última vuelta */
+    uint32_t countdown_ms;           /**< Tiempo restante de la cuenta regresiva */
+    clock_event_t countdown_expired; /**< Aviso de fin de la cuenta regresiva */
+    void * countdown_context;        /**< Contexto del aviso de fin de la cuenta regresiva */
 };
 
 /* === Private function definitions ================================================================================ */
 
+static __raminline bool IsLeapYear(uint16_t year) {
+    return ((year % 4) == 0) && (((year % 100) != 0) || ((year % 400) == 0));
+}
+
+//! Días del mes sin validar el mes, que NextDay ya recibe dentro del rango
+static __raminline uint8_t DaysInMonth(uint16_t year, uint8_t month) {
+    return DAYS_IN_MONTH[month - 1] + (((month == 2) && IsLeapYear(year)) ? 1 : 0);
+}
+
+//! En la SRAM como ClockNewTick, que la llama con el acarreo de medianoche
+__ramfunc static void NextDay(clock_date_t * date) {
+    date->weekday = (date->weekday == 6) ? 0 : date->weekday + 1;
+
+    date->day++;
+    if (date->day > DaysInMonth(date->year, date->month)) {
+        date->day = 1;
+        date->month++;
+        if (date->month > 12) {
+            date->month = 1;
+            date->year++;
+            if (date->year > CLOCK_YEAR_MAX) {
+                date->year = CLOCK_YEAR_MIN; /**< Igual que al ajustar el año, el calendario vuelve a empezar */
+                date->weekday = CLOCK_YEAR_MIN_WDAY;
+            }
+        }
+    }
+}
+
 /* === Public function implementation ============================================================================== */
 
 clock_t ClockCreate(void) {
     static struct clock_s self[1];
     memset(self, 0, sizeof(struct clock_s));
     self->valid = false;
+    self->alarm_days = CLOCK_EVERY_DAY;
+    self->date.year = CLOCK_DEFAULT_YEAR;
+    self->date.month = 1;
+    self->date.day = 1;
+    self->date.weekday = CLOCK_DEFAULT_WDAY;
     return self;
 }
 
@@ -70,9 +133,7 @@ bool ClockGetTime(clock_t self, clock_time_t * result) {
 }
 
 bool ClockSetTime(clock_t self, const clock_time_t * new_time) {
-    if (new_time == NULL || new_time->time.hours[0] > 9 || new_time->time.hours[1] > 2 ||
-        (new_time->time.hours[1] == 2 && new_time->time.hours[0] > 3) || new_time->time.minutes[0] > 9 ||
-        new_time->time.minutes[1] > 5 || new_time->time.seconds[0] > 9 || new_time->time.seconds[1] > 5) {
+    if (new_time == NULL || !BcdTimeIsValid(new_time)) {
         self->valid = false;
     } else {
         self->valid = true;
@@ -82,49 +143,40 @@ bool ClockSetTime(clock_t self, const clock_time_t * new_time) {
     return self->valid;
 }
 
-void ClockNewTick(clock_t self) {
+__ramfunc void ClockNewTick(clock_t self) {
+    // Sin cronómetros en marcha el tick solo paga estas dos comparaciones. Cada indicador es un byte que se escribe
+    // completo, así la tarea que los controla y el tick nunca pisan el valor del otro.
+    if (self->stopwatch_running) {
+        self->stopwatch_ms++;
+    }
+    if (self->countdown_running) {
+        if ((self->countdown_ms == 0) || (--self->countdown_ms == 0)) {
+            self->countdown_running = false;
+            if (self->countdown_expired != NULL) {
+                self->countdown_expired(self->countdown_context);
+            }
+        }
+    }
+
     self->ticks_per_second++;
     if (self->ticks_per_second == 1000) { /**< 1000 ticks por segundo = 1 segundo */
         self->ticks_per_second = 0;
-        self->current_time.time.seconds[0]++;
-        if (self->current_time.time.seconds[0] > 9) {
-            self->current_time.time.seconds[0] = 0;
-            self->current_time.time.seconds[1]++;
-            if (self->current_time.time.seconds[1] > 5) {
-                self->current_time.time.seconds[1] = 0;
-                self->current_time.time.minutes[0]++;
-                if (self->current_time.time.minutes[0] > 9) {
-                    self->current_time.time.minutes[0] = 0;
-                    self->current_time.time.minutes[1]++;
-                    if (self->current_time.time.minutes[1] > 5) {
-                        self->current_time.time.minutes[1] = 0;
-                        self->current_time.time.hours[0]++;
-                        if (self->current_time.time.hours[0] > 9) {
-                            self->current_time.time.hours[0] = 0;
-                            self->current_time.time.hours[1]++;
-                        }
-                        if (self->current_time.time.hours[1] > 2 ||
-                            (self->current_time.time.hours[1] == 2 && self->current_time.time.hours[0] > 3)) {
-                            self->current_time.time.hours[1] = 0;
-                            self->current_time.time.hours[0] = 0;
-                        }
-                    }
-                }
-            }
+        if (BcdTimeIncrement(&self->current_time)) { /**< Todos los dígitos con su acarreo en una sola operación */
+            NextDay(&self->date); /**< La fecha solo se toca con el acarreo de medianoche */
         }
     }
 }
 
 bool ClockSetAlarm(clock_t self, const clock_time_t * alarm_time) {
-    self->valid = true;
+    self->alarm_valid = true; /**< La hora del reloj sigue sin ajustar hasta que se la configure */
     memcpy(&self->alarm_time, alarm_time, sizeof(clock_time_t));
     memcpy(&self->snoozed_alarm_time, alarm_time, sizeof(clock_time_t));
-    return self->valid;
+    return self->alarm_valid;
 }
 
 bool ClockGetAlarm(clock_t self, clock_time_t * alarm_time) {
     memcpy(alarm_time, &self->alarm_time, sizeof(clock_time_t));
-    return self->valid;
+    return self->alarm_valid;
 }
 
 bool ClockAlarmIsRinging(clock_t self) {
@@ -134,7 +186,7 @@ bool ClockAlarmIsRinging(clock_t self) {
         self->current_time.time.minutes[1] == self->snoozed_alarm_time.time.minutes[1] &&
         self->current_time.time.seconds[0] == self->snoozed_alarm_time.time.seconds[0] &&
         self->current_time.time.seconds[1] == self->snoozed_alarm_time.time.seconds[1]) {
-        if (self->alarm_enabled) {
+        if (self->alarm_enabled && (self->alarm_days & (1U << self->date.weekday))) {
             self->alarm_ringing = true;
         } else {
             memcpy(&self->snoozed_alarm_time, &self->alarm_time, sizeof(clock_time_t));
@@ -195,24 +247,13 @@ bool ClockPostponeAlarmRandomMinutes(clock_t self, uint8_t minutes) {
 
     self->alarm_ringing = false;
 
-    /**< Convertir la hora actual de la alarma a minutos totales */
-    uint8_t hours = self->current_time.time.hours[1] * 10 + self->current_time.time.hours[0];
-    uint8_t mins = self->current_time.time.minutes[1] * 10 + self->current_time.time.minutes[0];
-
-    uint16_t total_minutes = hours * 60 + mins;
-
-    /**< Sumar los minutos */
-    total_minutes = (total_minutes + minutes) % 1440; /**< 1440 = 24 * 60 minutos */
+    /**< Sumar los minutos a la hora actual, sin sus segundos */
+    clock_time_t snoozed;
+    uint32_t seconds = BcdTimeToSeconds(&self->current_time);
+    BcdTimeFromSeconds(&snoozed, seconds - (seconds % 60) + minutes * 60);
 
-    /**< Convertir de nuevo a horas y minutos */
-    uint8_t new_hours = total_minutes / 60;
-    uint8_t new_minutes = total_minutes % 60;
-
-    /**< Guardar en formato BCD nuevamente */
-    self->snoozed_alarm_time.time.hours[1] = new_hours / 10;
-    self->snoozed_alarm_time.time.hours[0] = new_hours % 10;
-    self->snoozed_alarm_time.time.minutes[1] = new_minutes / 10;
-    self->snoozed_alarm_time.time.minutes[0] = new_minutes % 10;
+    /**< Guardar horas y minutos, los segundos de la alarma no cambian */
+    memcpy(&self->snoozed_alarm_time.bcd[2], &snoozed.bcd[2], 4);
 
     return true;
 }
@@ -222,6 +263,140 @@ void ClockPostponeAlarmOneDay(clock_t self) {
     self->snoozed_alarm_time = self->alarm_time; /**< Guardar la hora de la alarma original */
 }
 
+bool ClockGetDate(clock_t self, clock_date_t * date) {
+    memcpy(date, &self->date, sizeof(clock_date_t));
+    return self->date_valid;
+}
+
+bool ClockSetDate(clock_t self, const clock_date_t * date) {
+    if ((date == NULL) || (date->year < CLOCK_YEAR_MIN) || (date->year > CLOCK_YEAR_MAX) || (date->day == 0) ||
+        (date->day > ClockDaysInMonth(date->year, date->month))) {
+        return false;
+    }
+
+    self->date.year = date->year;
+    self->date.month = date->month;
+    self->date.day = date->day;
+    self->date.weekday = ClockWeekday(date->year, date->month, date->day);
+    self->date_valid = true;
+    return true;
+}
+
+bool ClockSync(clock_t self, const clock_time_t * time, const clock_date_t * date, uint32_t elapsed_ms) {
+    if ((time == NULL) || !BcdTimeIsValid(time)) {
+        return false;
+    }
+    if ((date != NULL) && !ClockSetDate(self, date)) {
+        return false;
+    }
+
+    memcpy(&self->current_time, time, sizeof(clock_time_t));
+    self->valid = true;
+    for (; elapsed_ms >= 1000; elapsed_ms -= 1000) {
+        if (BcdTimeIncrement(&self->current_time)) {
+            NextDay(&self->date); /**< El mensaje puede haber llegado justo después de medianoche */
+        }
+    }
+    self->ticks_per_second = elapsed_ms;
+    return true;
+}
+
+int16_t ClockAlignSecond(clock_t self, uint16_t elapsed_ms) {
+    int16_t phase;
+
+    if (!self->valid || (elapsed_ms >= 1000)) {
+        return 0;
+    }
+
+    // Fase que tenía el reloj en el instante del pulso, donde debería haber comenzado un segundo
+    phase = ((int16_t)self->ticks_per_second - (int16_t)elapsed_ms + 1000) % 1000;
+    self->ticks_per_second = elapsed_ms;
+    if (phase < 500) {
+        return -phase; /**< El segundo ya había comenzado, el reloj estaba adelantado */
+    }
+    if (BcdTimeIncrement(&self->current_time)) { /**< El segundo todavía no había comenzado, adelantarlo */
+        NextDay(&self->date);
+    }
+    return 1000 - phase;
+}
+
+uint16_t ClockGetMilliseconds(clock_t self) {
+    return self->ticks_per_second;
+}
+
+void ClockSetAlarmDays(clock_t self, uint8_t days) {
+    self->alarm_days = days & CLOCK_EVERY_DAY;
+}
+
+uint8_t ClockGetAlarmDays(clock_t self) {
+    return self->alarm_days;
+}
+
+uint8_t ClockDaysInMonth(uint16_t year, uint8_t month) {
+    if ((month == 0) || (month > 12)) {
+        return 0;
+    }
+    return DaysInMonth(year, month);
+}
+
+uint8_t ClockWeekday(uint16_t year, uint8_t month, uint8_t day) {
+    if (month < 3) {
+        year--; /**< Enero y febrero cuentan como el final del año anterior, así el 29 de febrero queda al final */
+    }
+    return (year + year / 4 - year / 100 + year / 400 + MONTH_WEEKDAY_OFFSET[month - 1] + day) % 7;
+}
+
+void ClockStopwatchRun(clock_t self, bool run) {
+    self->stopwatch_running = run;
+}
+
+void ClockStopwatchReset(clock_t self) {
+    self->stopwatch_ms = 0;
+    self->stopwatch_lap = 0;
+}
+
+uint32_t ClockStopwatchRead(clock_t self) {
+    return self->stopwatch_ms;
+}
+
+uint32_t ClockStopwatchLap(clock_t self) {
+    uint32_t now = self->stopwatch_ms; /**< Una sola lectura, el tick puede avanzarlo en cualquier momento */
+    uint32_t lap = now - self->stopwatch_lap;
+
+    self->stopwatch_lap = now;
+    return lap;
+}
+
+bool ClockStopwatchIsRunning(clock_t self) {
+    return self->stopwatch_running;
+}
+
+void ClockCountdownSet(clock_t self, uint32_t milliseconds) {
+    self->countdown_running = false;
+    self->countdown_ms = milliseconds;
+}
+
+bool ClockCountdownRun(clock_t self, bool run) {
+    if (run && (self->countdown_ms == 0)) {
+        return false;
+    }
+    self->countdown_running = run;
+    return true;
+}
+
+uint32_t ClockCountdownRead(clock_t self) {
+    return self->countdown_ms;
+}
+
+bool ClockCountdownIsRunning(clock_t self) {
+    return self->countdown_running;
+}
+
+void ClockCountdownOnExpire(clock_t self, clock_event_t handler, void * context) {
+    self->countdown_expired = handler;
+    self->countdown_context = context;
+}
+
 void IncrementMinutes(clock_time_t * clock) {
     clock->time.minutes[0]++;
     if (clock->time.minutes[0] > 9) {
@@ -0,0 +1,522 @@
+/*********************************************************************************************************************
+Copyright (c) 2025, Martín Fernando Gareca del autor <mfgareca36@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*********************************************************************************************************************/
+
+/** @file console.c
+ ** @brief Implementación de la consola de órdenes y telemetría por puerto serie
+ **/
+
+/* === Headers files inclusions ==================================================================================== */
+
+#include "console.h"
+#include "bcd.h"
+#include "display.h"
+#include "monitor.h"
+#include "power.h"
+#include "sync.h"
+#include "timeMEF.h"
+#include "trace.h"
+#include "task.h"
+#include <stddef.h>
+
+/* === Macros definitions ========================================================================================== */
+
+#if ((CONSOLE_RX_SIZE & (CONSOLE_RX_SIZE - 1)) != 0) || ((CONSOLE_TX_SIZE & (CONSOLE_TX_SIZE - 1)) != 0)
+#error "CONSOLE_RX_SIZE y CONSOLE_TX_SIZE deben ser potencias de dos"
+#endif
+
+#define RX_MASK (CONSOLE_RX_SIZE - 1)
+#define TX_MASK (CONSOLE_TX_SIZE - 1)
+
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof(a[0]))
+
+/* === Private data type declarations ============================================================================== */
+
+//! Parte de una línea que falta interpretar, apunta al buffer de recepción en lugar de copiar la línea
+typedef struct console_cursor_s {
+    const uint8_t * ring; /**< Buffer circular de recepción */
+    uint16_t position;    /**< Posición del próximo carácter, se recorta con RX_MASK al leer */
+    uint16_t remaining;   /**< Caracteres que quedan en la línea */
+} console_cursor_t;
+
+//! Orden de la consola
+typedef struct console_command_s {
+    const char * name;                        /**< Palabra que la identifica */
+    void (*Execute)(console_cursor_t * args); /**< Función que la ejecuta con el resto de la línea */
+    const char * help;                        /**< Descripción para la orden ayuda */
+} console_command_t;
+
+//! Estado de la consola
+struct console_s {
+    console_port_t port;         /**< Puerto serie de la consola */
+    clock_t clock;               /**< Reloj que se consulta y se ajusta */
+    uint16_t rx_tail;            /**< Posición del próximo byte recibido sin procesar */
+    uint16_t line_start;         /**< Posición del primer carácter de la línea en curso */
+    uint16_t line_length;        /**< Caracteres de la línea en curso */
+    bool discarding;             /**< La línea en curso es demasiado larga y se descarta hasta su fin */
+    uint16_t tx_head;            /**< Bytes escritos en el buffer de transmisión, sin recortar */
+    uint16_t tx_tail;            /**< Bytes ya enviados, sin recortar */
+    uint16_t tx_sending;         /**< Bytes del bloque que el puerto está enviando */
+    uint32_t tx_dropped;         /**< Bytes descartados por falta de lugar en el buffer de transmisión */
+    uint8_t tx[CONSOLE_TX_SIZE]; /**< Buffer circular de transmisión */
+};
+
+/* === Private function declarations =============================================================================== */
+
+static int Peek(const console_cursor_t * cursor);
+
+static void SkipSpaces(console_cursor_t * cursor);
+
+static bool MatchWord(console_cursor_t * cursor, const char * word);
+
+static bool MatchChar(console_cursor_t * cursor, char expected);
+
+static bool ReadNumber(console_cursor_t * cursor, uint8_t digits, uint16_t * value);
+
+static bool ReadTime(console_cursor_t * cursor, clock_time_t * time, bool seconds);
+
+static bool AtEnd(console_cursor_t * cursor);
+
+static void WriteChar(char character);
+
+static void Write(const char * text);
+
+static void WriteNumber(uint32_t value, uint8_t width);
+
+static void WritePermille(uint32_t permille);
+
+static void WriteTime(const clock_time_t * time, bool seconds);
+
+static void Execute(uint16_t start, uint16_t length);
+
+static void SendPending(void);
+
+static void CommandHelp(console_cursor_t * args);
+
+static void CommandTime(console_cursor_t * args);
+
+static void CommandDate(console_cursor_t * args);
+
+static void CommandAlarm(console_cursor_t * args);
+
+static void CommandUtc(console_cursor_t * args);
+
+static void CommandStats(console_cursor_t * args);
+
+/* === Private variable definitions ================================================================================ */
+
+static const console_command_t COMMANDS[] = {
+    {"ayuda", CommandHelp, "lista las ordenes"},
+    {"hora", CommandTime, "[HH:MM[:SS]] muestra o ajusta la hora"},
+    {"fecha", CommandDate, "[AAAA-MM-DD] muestra o ajusta la fecha"},
+    {"alarma", CommandAlarm, "[HH:MM] muestra o ajusta la alarma, se activa con las teclas"},
+    {"utc", CommandUtc, "[+HH:MM] muestra o ajusta la diferencia con la hora UTC de la referencia"},
+    {"estado", CommandStats, "tareas, memoria, servicio, consumo, traza y sincronia"},
+};
+
+static const char * const WAKE_NAMES[POWER_WAKE_SOURCES] = {"tick", "pantalla", "zumbador", "otras"};
+
+static struct console_s self[1];
+
+/* === Public variable definitions ================================================================================= */
+
+/* === Private function definitions ================================================================================ */
+
+static int Peek(const console_cursor_t * cursor) {
+    return (cursor->remaining != 0) ? cursor->ring[cursor->position & RX_MASK] : -1;
+}
+
+static void SkipSpaces(console_cursor_t * cursor) {
+    while (Peek(cursor) == ' ') {
+        cursor->position++;
+        cursor->remaining--;
+    }
+}
+
+static bool MatchWord(console_cursor_t * cursor, const char * word) {
+    console_cursor_t probe = *cursor;
+
+    SkipSpaces(&probe);
+    while (*word != '\0') {
+        if (Peek(&probe) != *word) {
+            return false;
+        }
+        probe.position++;
+        probe.remaining--;
+        word++;
+    }
+    if ((Peek(&probe) != ' ') && (Peek(&probe) != -1)) {
+        return false; /**< La palabra de la línea es más larga */
+    }
+    *cursor = probe;
+    return true;
+}
+
+static bool MatchChar(console_cursor_t * cursor, char expected) {
+    if (Peek(cursor) != expected) {
+        return false;
+    }
+    cursor->position++;
+    cursor->remaining--;
+    return true;
+}
+
+static bool ReadNumber(console_cursor_t * cursor, uint8_t digits, uint16_t * value) {
+    int character;
+
+    *value = 0;
+    for (uint8_t i = 0; i < digits; i++) {
+        character = Peek(cursor);
+        if ((character < '0') || (character > '9')) {
+            return false;
+        }
+        *value = *value * 10 + (character - '0');
+        cursor->position++;
+        cursor->remaining--;
+    }
+    return true;
+}
+
+static bool ReadTime(console_cursor_t * cursor, clock_time_t * time, bool seconds) {
+    uint16_t hours;
+    uint16_t minutes;
+    uint16_t secs = 0;
+
+    SkipSpaces(cursor);
+    if (!ReadNumber(cursor, 2, &hours) || !MatchChar(cursor, ':') || !ReadNumber(cursor, 2, &minutes)) {
+        return false;
+    }
+    if (seconds && MatchChar(cursor, ':') && !ReadNumber(cursor, 2, &secs)) {
+        return false;
+    }
+
+    time->time.hours[1] = hours / 10;
+    time->time.hours[0] = hours % 10;
+    time->time.minutes[1] = minutes / 10;
+    time->time.minutes[0] = minutes % 10;
+    time->time.seconds[1] = secs / 10;
+    time->time.seconds[0] = secs % 10;
+    return AtEnd(cursor) && BcdTimeIsValid(time);
+}
+
+static bool AtEnd(console_cursor_t * cursor) {
+    SkipSpaces(cursor);
+    return cursor->remaining == 0;
+}
+
+static void WriteChar(char character) {
+    if ((uint16_t)(self->tx_head - self->tx_tail) < CONSOLE_TX_SIZE) {
+        self->tx[self->tx_head & TX_MASK] = character;
+        self->tx_head++;
+    } else {
+        self->tx_dropped++; /**< Nunca se espera al puerto, lo que no entra se pierde */
+    }
+}
+
+static void Write(const char * text) {
+    while (*text != '\0') {
+        WriteChar(*text);
+        text++;
+    }
+}
+
+static void WriteNumber(uint32_t value, uint8_t width) {
+    char text[11];
+    uint8_t position = sizeof(text) - 1;
+
+    text[position] = '\0';
+    do {
+        text[--position] = '0' + (value % 10);
+        value /= 10;
+    } while ((value != 0) && (position > 0));
+    while ((sizeof(text) - 1 - position < width) && (position > 0)) {
+        text[--position] = '0';
+    }
+    Write(&text[position]);
+}
+
+static void WritePermille(uint32_t permille) {
+    WriteNumber(permille / 10, 1);
+    Write(".");
+    WriteNumber(permille % 10, 1);
+    Write("%");
+}
+
+static void WriteTime(const clock_time_t * time, bool seconds) {
+    WriteNumber(time->time.hours[1] * 10 + time->time.hours[0], 2);
+    Write(":");
+    WriteNumber(time->time.minutes[1] * 10 + time->time.minutes[0], 2);
+    if (seconds) {
+        Write(":");
+        WriteNumber(time->time.seconds[1] * 10 + time->time.seconds[0], 2);
+    }
+}
+
+static void Execute(uint16_t start, uint16_t length) {
+    console_cursor_t cursor = {self->port->rx_buffer, start, length};
+
+    for (uint8_t i = 0; i < ARRAY_SIZE(COMMANDS); i++) {
+        if (MatchWord(&cursor, COMMANDS[i].name)) {
+            COMMANDS[i].Execute(&cursor);
+            return;
+        }
+    }
+    Write("orden desconocida, escriba ayuda\r\n");
+}
+
+static void SendPending(void) {
+    uint16_t start;
+    uint16_t size;
+
+    while ((self->tx_sending == 0) || !self->port->TxBusy()) {
+        self->tx_tail += self->tx_sending; /**< El bloque anterior ya salió */
+        size = self->tx_head - self->tx_tail;
+        start = self->tx_tail & TX_MASK;
+        if (size > CONSOLE_TX_SIZE - start) {
+            size = CONSOLE_TX_SIZE - start; /**< Hasta el final del buffer, el resto sale en el próximo bloque */
+        }
+        self->tx_sending = size;
+        if (size == 0) {
+            break;
+        }
+        self->port->TxStart(&self->tx[start], size);
+    }
+}
+
+static void CommandHelp(console_cursor_t * args) {
+    (void)args;
+    for (uint8_t i = 0; i < ARRAY_SIZE(COMMANDS); i++) {
+        Write(COMMANDS[i].name);
+        Write(" ");
+        Write(COMMANDS[i].help);
+        Write("\r\n");
+    }
+}
+
+static void CommandTime(console_cursor_t * args) {
+    clock_time_t time;
+    bool accepted = false;
+
+    if (AtEnd(args)) {
+        if (!ClockGetTime(self->clock, &time)) {
+            Write("sin ajustar ");
+        }
+        WriteTime(&time, true);
+        Write("\r\n");
+        return;
+    }
+
+    if (ReadTime(args, &time, true)) {
+        taskENTER_CRITICAL(); // El servicio de 1 kHz no puede avanzar la hora mientras se reemplaza
+        accepted = ClockSetTime(self->clock, &time);
+        taskEXIT_CRITICAL();
+    }
+    Write(accepted ? "ok\r\n" : "error, use HH:MM o HH:MM:SS\r\n");
+}
+
+static void CommandDate(console_cursor_t * args) {
+    static const char * const WEEKDAYS[] = {"dom", "lun", "mar", "mie", "jue", "vie", "sab"};
+    clock_date_t date;
+    uint16_t month;
+    uint16_t day;
+    bool accepted = false;
+
+    if (AtEnd(args)) {
+        if (!ClockGetDate(self->clock, &date)) {
+            Write("sin ajustar ");
+        }
+        WriteNumber(date.year, 4);
+        Write("-");
+        WriteNumber(date.month, 2);
+        Write("-");
+        WriteNumber(date.day, 2);
+        Write(" ");
+        Write(WEEKDAYS[date.weekday % ARRAY_SIZE(WEEKDAYS)]);
+        Write("\r\n");
+        return;
+    }
+
+    if (ReadNumber(args, 4, &date.year) && MatchChar(args, '-') && ReadNumber(args, 2, &month) &&
+        MatchChar(args, '-') && ReadNumber(args, 2, &day) && AtEnd(args)) {
+        date.month = month;
+        date.day = day;
+        taskENTER_CRITICAL(); // Igual que la hora, la medianoche del servicio no puede pisar la fecha nueva
+        accepted = ClockSetDate(self->clock, &date);
+        taskEXIT_CRITICAL();
+    }
+    Write(accepted ? "ok\r\n" : "error, use AAAA-MM-DD\r\n");
+}
+
+static void CommandAlarm(console_cursor_t * args) {
+    clock_time_t time;
+
+    if (AtEnd(args)) {
+        ClockGetAlarm(self->clock, &time);
+        WriteTime(&time, false);
+        Write(" dias ");
+        for (uint8_t day = 0; day < 7; day++) {
+            WriteChar((ClockGetAlarmDays(self->clock) & (1U << day)) ? "DLMMJVS"[day] : '-');
+        }
+        Write("\r\n");
+    } else if (ReadTime(args, &time, false) && MEFSetAlarm(self->clock, &time)) {
+        Write("ok\r\n");
+    } else {
+        Write("error, use HH:MM\r\n");
+    }
+}
+
+static void CommandUtc(console_cursor_t * args) {
+    int16_t offset;
+    uint16_t hours;
+    uint16_t minutes;
+    bool negative;
+
+    if (AtEnd(args)) {
+        offset = SyncGetUtcOffset();
+        WriteChar((offset < 0) ? '-' : '+');
+        offset = (offset < 0) ? -offset : offset;
+        WriteNumber(offset / 60, 2);
+        Write(":");
+        WriteNumber(offset % 60, 2);
+        Write("\r\n");
+        return;
+    }
+
+    negative = MatchChar(args, '-');
+    if ((negative || MatchChar(args, '+')) && ReadNumber(args, 2, &hours) && MatchChar(args, ':') &&
+        ReadNumber(args, 2, &minutes) && (minutes < 60) && AtEnd(args)) {
+        offset = hours * 60 + minutes;
+        if (SyncSetUtcOffset(negative ? -offset : offset)) {
+            MEFRequestSave(); /**< La MEF guarda la configuración completa */
+            Write("ok\r\n");
+            return;
+        }
+    }
+    Write("error, use +HH:MM o -HH:MM\r\n");
+}
+
+static void CommandStats(console_cursor_t * args) {
+    const monitor_report_t * report = MonitorGetReport();
+    power_stats_t power;
+    sync_stats_t sync;
+
+    (void)args;
+    for (uint8_t i = 0; i < report->task_count; i++) {
+        Write(report->tasks[i].name);
+        Write(" cpu ");
+        WritePermille(report->tasks[i].cpu_permille);
+        Write(" pila ");
+        WriteNumber(report->tasks[i].stack_free_words, 1);
+        Write("\r\n");
+    }
+    Write("heap ");
+    WriteNumber(report->heap_free, 1);
+    Write(" minimo ");
+    WriteNumber(report->heap_minimum_free, 1);
+    Write("\r\nservicio peor caso ");
+    WriteNumber(ServiceWorstCaseUs(), 1);
+    Write(" us excesos ");
+    WriteNumber(ServiceOverruns(), 1);
+    Write("\r\nmargen activo ");
+    WritePermille(PowerHeadroom(POWER_MODE_ACTIVE));
+    Write(" pantalla ");
+    WritePermille(PowerHeadroom(POWER_MODE_DISPLAY));
+    Write("\r\ndespertares");
+    PowerGetStats(&power);
+    for (uint8_t i = 0; i < POWER_WAKE_SOURCES; i++) {
+        Write(" ");
+        Write(WAKE_NAMES[i]);
+        Write(" ");
+        WriteNumber(power.wakes[i], 1);
+    }
+    Write("\r\ntraza ");
+    WriteNumber(TraceGetLog()->head, 1);
+    Write(" eventos\r\nconsola descartados ");
+    WriteNumber(self->tx_dropped, 1);
+    Write("\r\nsincronia mensajes ");
+    SyncGetStats(&sync);
+    WriteNumber(sync.messages, 1);
+    Write(" rechazados ");
+    WriteNumber(sync.rejected, 1);
+    Write(" pulsos ");
+    WriteNumber(sync.pulses, 1);
+    Write(" correccion ");
+    if (sync.offset_ms < 0) {
+        WriteChar('-');
+    }
+    WriteNumber((sync.offset_ms < 0) ? -sync.offset_ms : sync.offset_ms, 1);
+    Write(sync.pulse_locked ? " ms con pulso\r\n" : " ms\r\n");
+}
+
+/* === Public function definitions ================================================================================= */
+
+void ConsoleInit(console_port_t port, clock_t clock) {
+    self->port = port;
+    self->clock = clock;
+    self->rx_tail = port->RxPosition() & RX_MASK; /**< Lo recibido antes de arrancar no es una orden */
+    self->line_start = self->rx_tail;
+    self->line_length = 0;
+    self->discarding = false;
+    self->tx_head = 0;
+    self->tx_tail = 0;
+    self->tx_sending = 0;
+    self->tx_dropped = 0;
+    Write("\r\nreloj listo, escriba ayuda\r\n");
+}
+
+void ConsolePoll(void) {
+    uint16_t head = self->port->RxPosition() & RX_MASK;
+    uint8_t character;
+
+    while (self->rx_tail != head) {
+        character = self->port->rx_buffer[self->rx_tail];
+        self->rx_tail = (self->rx_tail + 1) & RX_MASK;
+
+        if ((character == '\r') || (character == '\n')) {
+            if (character == '\r') {
+                Write("\r\n"); /**< Eco del fin de línea para las terminales sin eco local */
+            }
+            if (!self->discarding && (self->line_length != 0)) {
+                Execute(self->line_start, self->line_length);
+            }
+            self->discarding = false;
+            self->line_length = 0;
+            self->line_start = self->rx_tail;
+        } else {
+            WriteChar(character); /**< Eco */
+            if (self->line_length < CONSOLE_LINE_MAX) {
+                self->line_length++;
+            } else {
+                self->discarding = true;
+            }
+        }
+    }
+    SendPending();
+}
+
+void ConsoleTask(void * pointer) {
+    console_task_args_t args = pointer;
+
+    ConsoleInit(args->port, args->clock);
+    while (1) {
+        vTaskDelay(pdMS_TO_TICKS(CONSOLE_PERIOD_MS));
+        ConsolePoll();
+    }
+}
+
+/* === End of documentation ======================================================================================== */
@@ -48,6 +48,19 @@ struct digital_input_s {
     bool lastState; /*!< Último estado conocido de la entrada */
 };
 
+//! Estructura que representa un grupo de entradas digitales
+struct digital_group_s {
+    uint8_t count;                              /*!< Cantidad de entradas del grupo */
+    uint8_t ports;                              /*!< Cantidad de puertos distintos */
+    uint8_t gpio[DIGITAL_GROUP_MAX_PORTS];      /*!< Puertos que se leen */
+    uint32_t inverted[DIGITAL_GROUP_MAX_PORTS]; /*!< Pines invertidos de cada puerto */
+    uint8_t port[DIGITAL_GROUP_MAX_INPUTS];     /*!< Índice del puerto de cada entrada */
+    uint8_t bit[DIGITAL_GROUP_MAX_INPUTS];      /*!< Pin de cada entrada dentro de su puerto */
+    uint32_t state;                             /*!< Entradas activas después del filtro antirrebote */
+    uint32_t samples[DIGITAL_DEBOUNCE_BITS];    /*!< Contadores verticales, lecturas distintas del estado */
+    uint32_t limit[DIGITAL_DEBOUNCE_BITS];      /*!< Lecturas necesarias de cada entrada, en planos de bits */
+};
+
 /* === Private function declarations =============================================================================== */
 
 /* === Private variable definitions ================================================================================ */
@@ -62,13 +75,14 @@ digital_output_t DigitalOutputCreate(uint8_t gpio, uint8_t bit, bool inverted) {
         self->gpio = gpio;
         self->bit = bit;
         self->inverted = inverted;
-        Chip_GPIO_SetPinState(LPC_GPIO_PORT, self->gpio, self->bit, inverted);
-        Chip_GPIO_SetPinDIR(LPC_GPIO_PORT, self->gpio, self->bit, true);
     }
     return self;
 }
 
 void DigitalOutputActivate(digital_output_t self) {
+    if (self == NULL) {
+        return;
+    }
     if (self->inverted == 0) {
         Chip_GPIO_SetPinState(LPC_GPIO_PORT, self->gpio, self->bit, false);
     } else {
@@ -77,6 +91,9 @@ void DigitalOutputActivate(digital_output_t self) {
 }
 
 void DigitalOutputDeactivate(digital_output_t self) {
+    if (self == NULL) {
+        return;
+    }
     if (self->inverted == 0) {
         Chip_GPIO_SetPinState(LPC_GPIO_PORT, self->gpio, self->bit, true);
     } else {
@@ -85,6 +102,9 @@ void DigitalOutputDeactivate(digital_output_t self) {
 }
 
 void DigitalOutputToggle(digital_output_t self) {
+    if (self == NULL) {
+        return;
+    }
     Chip_GPIO_SetPinToggle(LPC_GPIO_PORT, self->gpio, self->bit);
 }
 
@@ -97,10 +117,6 @@ digital_input_t DigitalInputCreate(uint8_t gpio, uint8_t bit, bool inverted) {
         self->bit = bit;
         self->inverted = inverted;
         self->lastState = DigitalInputGetIsActive(self);
-
-        Chip_GPIO_SetPinDIR(LPC_GPIO_PORT, self->gpio, self->bit, false);
-
-        self->lastState = DigitalInputGetIsActive(self);
     }
     return self;
 }
@@ -136,4 +152,98 @@ bool DigitalWasDeactivated(digital_input_t self) {
     return DIGITAL_INPUT_WAS_DEACTIVATED == DigitalWasChanged(self);
 }
 
+/* ----------------------------------------------------------------------------------------------------------------- */
+
+digital_group_t DigitalGroupCreate(const digital_input_t inputs[], uint8_t count) {
+    digital_group_t self;
+    uint8_t index;
+    uint8_t port;
+
+    if ((inputs == NULL) || (count == 0) || (count > DIGITAL_GROUP_MAX_INPUTS)) {
+        return NULL;
+    }
+
+    self = calloc(1, sizeof(struct digital_group_s));
+    if (self != NULL) {
+        self->count = count;
+        for (index = 0; index < count; index++) {
+            for (port = 0; (port < self->ports) && (self->gpio[port] != inputs[index]->gpio); port++) {
+            }
+            if (port == self->ports) {
+                if (self->ports == DIGITAL_GROUP_MAX_PORTS) {
+                    free(self);
+                    return NULL;
+                }
+                self->gpio[port] = inputs[index]->gpio; /*!< Primera entrada de este puerto */
+                self->ports++;
+            }
+            if (inputs[index]->inverted) {
+                self->inverted[port] |= 1UL << inputs[index]->bit;
+            }
+            self->port[index] = port;
+            self->bit[index] = inputs[index]->bit;
+        }
+        DigitalGroupSetDebounce(self, 0xFFFFFFFF, 1); /*!< Sin filtro hasta que se configure */
+    }
+    return self;
+}
+
+void DigitalGroupRead(digital_group_t self, digital_snapshot_t * snapshot) {
+    uint32_t value[DIGITAL_GROUP_MAX_PORTS];
+    uint32_t active = 0;
+    uint32_t differ;
+    uint32_t carry;
+    uint32_t mismatch;
+    uint32_t stable;
+    uint8_t index;
+    uint8_t plane;
+
+    for (index = 0; index < self->ports; index++) {
+        value[index] = Chip_GPIO_ReadValue(LPC_GPIO_PORT, self->gpio[index]) ^ self->inverted[index];
+    }
+    for (index = 0; index < self->count; index++) {
+        active |= ((value[self->port[index]] >> self->bit[index]) & 1UL) << index;
+    }
+
+    // Cada plano guarda un bit del contador de todas las entradas: el contador avanza en las que difieren del
+    // estado filtrado y vuelve a cero en las demás, con el acarreo propagado en paralelo de plano en plano
+    differ = active ^ self->state;
+    carry = differ;
+    mismatch = 0;
+    for (plane = 0; plane < DIGITAL_DEBOUNCE_BITS; plane++) {
+        self->samples[plane] ^= carry;
+        carry &= ~self->samples[plane];
+        self->samples[plane] &= differ;
+        mismatch |= self->samples[plane] ^ self->limit[plane];
+    }
+    stable = differ & ~mismatch; /*!< Entradas que alcanzaron sus lecturas iguales */
+    for (plane = 0; plane < DIGITAL_DEBOUNCE_BITS; plane++) {
+        self->samples[plane] &= ~stable;
+    }
+
+    // Los cambios de todas las entradas salen de las máscaras completas, sin comparar entrada por entrada
+    snapshot->changed = stable;
+    snapshot->active = self->state ^ stable;
+    snapshot->activated = stable & snapshot->active;
+    snapshot->deactivated = stable & ~snapshot->active;
+    self->state = snapshot->active;
+}
+
+int DigitalGroupSetDebounce(digital_group_t self, uint32_t inputs, uint8_t samples) {
+    uint8_t plane;
+
+    if ((samples == 0) || (samples > DIGITAL_DEBOUNCE_MAX_SAMPLES)) {
+        return -1;
+    }
+
+    for (plane = 0; plane < DIGITAL_DEBOUNCE_BITS; plane++) {
+        if (samples & (1 << plane)) {
+            self->limit[plane] |= inputs;
+        } else {
+            self->limit[plane] &= ~inputs;
+        }
+    }
+    return 0;
+}
+
 /* === End of documentation ======================================================================================== */
@@ -24,15 +24,35 @@ SPDX-License-Identifier: MIT
 /* === Headers files inclusions ==================================================================================== */
 
 #include "display.h"
+#include "monitor.h"
+#include "trace.h"
+#include <stddef.h>
+#include <stdint.h>
 
 /* === Macros definitions ========================================================================================== */
 
 /* === Private data type declarations ============================================================================== */
 
+//! Función adicional del servicio
+typedef struct service_hook_s {
+    service_hook_t hook; /**< Función a llamar */
+    void * context;      /**< Contexto de la función */
+} service_hook_entry_t;
+
 /* === Private function declarations =============================================================================== */
 
 /* === Private variable definitions ================================================================================ */
 
+static service_hook_entry_t hooks[SERVICE_MAX_HOOKS];
+
+static volatile uint8_t hooks_count = 0;
+
+static uint32_t worst_cycles = 0; /**< Pasada más larga medida, en ciclos del núcleo */
+
+static uint32_t worst_us = 0; /**< La misma pasada en microsegundos, convertida con la frecuencia de ese momento */
+
+static uint32_t overruns = 0; /**< Pasadas que superaron SERVICE_BUDGET_US */
+
 /* === Public variable definitions ================================================================================= */
 
 /* === Private function definitions ================================================================================ */
@@ -41,21 +61,57 @@ SPDX-License-Identifier: MIT
 
 /* === Public function implementation ============================================================================== */
 
-void RefreshScreenTask(void * pointer) {
-    // screen_t args = pointer;
-    TickType_t last_value = xTaskGetTickCount();
-
-    while (1) {
-        ScreenRefresh(pointer);
-        xTaskDelayUntil(&last_value, pdMS_TO_TICKS(1));
+int ServiceAddHook(service_hook_t hook, void * context) {
+    if ((hook == NULL) || (hooks_count >= SERVICE_MAX_HOOKS)) {
+        return -1;
     }
+
+    hooks[hooks_count].hook = hook;
+    hooks[hooks_count].context = context;
+    hooks_count++; /**< La entrada queda completa antes de que el servicio la vea */
+    return 0;
+}
+
+uint32_t ServiceWorstCaseUs(void) {
+    return worst_us;
+}
+
+uint32_t ServiceWorstCaseCycles(void) {
+    return worst_cycles;
+}
+
+uint32_t ServiceOverruns(void) {
+    return overruns;
 }
 
-void TickTask(void * pointer) {
+void ServiceTask(void * pointer) {
+    service_args_t args = pointer;
     TickType_t last_value = xTaskGetTickCount();
+    uint32_t start;
+    uint32_t elapsed;
+    uint32_t elapsed_us;
 
     while (1) {
-        ClockNewTick(pointer);
+        start = MonitorCycleCount();
+
+        ClockNewTick(args->clock);     /**< Primero la hora, que no debe atrasarse */
+        ScreenRefresh(args->screen);   /**< Después un dígito de la pantalla */
+        for (uint8_t i = 0; i < hooks_count; i++) {
+            hooks[i].hook(hooks[i].context); /**< Por último las funciones adicionales, dentro de la medición */
+        }
+
+        // El contador de ciclos del núcleo mide cada pasada, la frecuencia puede cambiar entre una y otra
+        elapsed = MonitorCycleCount() - start;
+        elapsed_us = MonitorCyclesToUs(elapsed);
+        if (elapsed_us > SERVICE_BUDGET_US) {
+            overruns++;
+        }
+        if (elapsed > worst_cycles) {
+            worst_cycles = elapsed;
+            worst_us = elapsed_us;
+            TraceRecord(TRACE_EVENT_SERVICE, elapsed_us > SERVICE_BUDGET_US,
+                        (elapsed_us > UINT16_MAX) ? UINT16_MAX : elapsed_us);
+        }
         xTaskDelayUntil(&last_value, pdMS_TO_TICKS(1));
     }
 }
@@ -24,60 +24,75 @@ SPDX-License-Identifier: MIT
 /* === Headers files inclusions ==================================================================================== */
 
 #include "key.h"
+#include "trace.h"
 
 /* === Macros definitions ========================================================================================== */
 
-#define KEY_TASK_DELAY 100
-
 /* === Private data type declarations ============================================================================== */
 
 /* === Private function declarations =============================================================================== */
 
+/**
+ * @brief Convierte el tiempo estable pedido en lecturas del filtro antirrebote, dentro del rango que acepta
+ * @param debounce_ms Tiempo estable en milisegundos, 0 para usar KEY_DEBOUNCE_MS
+ * @return uint8_t Lecturas iguales necesarias, de 1 a DIGITAL_DEBOUNCE_MAX_SAMPLES
+ */
+static uint8_t DebounceSamples(uint16_t debounce_ms);
+
 /* === Private variable definitions ================================================================================ */
 
 /* === Public variable definitions ================================================================================= */
 
 /* === Private function definitions ================================================================================ */
 
+static uint8_t DebounceSamples(uint16_t debounce_ms) {
+    uint16_t samples = (debounce_ms ? debounce_ms : KEY_DEBOUNCE_MS) / KEY_SCAN_PERIOD_MS;
+
+    if (samples == 0) {
+        samples = 1; /**< Menos de un período de lectura equivale a no filtrar */
+    } else if (samples > DIGITAL_DEBOUNCE_MAX_SAMPLES) {
+        samples = DIGITAL_DEBOUNCE_MAX_SAMPLES;
+    }
+    return (uint8_t)samples;
+}
+
 /* === Public function definitions ================================================================================= */
 
 /* === Public function implementation ============================================================================== */
 
-void KeyTask(void * pointer) {
+void KeyScanTask(void * pointer) {
     key_task_args_t args = pointer;
+    digital_snapshot_t keys;
+    uint16_t held[8] = {0};
+    EventBits_t events;
+    uint8_t index;
+    int result;
 
-    while (1) {
-        while (!DigitalInputGetIsActive(args->gpio)) {
-            vTaskDelay(pdMS_TO_TICKS(KEY_TASK_DELAY));
-        }
-
-        xEventGroupSetBits(args->event_group, args->event_bit);
-
-        while (DigitalInputGetIsActive(args->gpio)) {
-            vTaskDelay(pdMS_TO_TICKS(KEY_TASK_DELAY));
-        }
-    }
-}
-
-void LargeKeyTask(void * pointer) {
-    key_task_args_t args = pointer;
-    TickType_t pressKey;
-    TickType_t xLastWakeTime;
+    result = DigitalGroupSetDebounce(args->keys, KEY_EVENT_ANY_KEY, DebounceSamples(args->debounce_ms));
+    configASSERT(result == 0);
+    (void)result;
 
     while (1) {
-        while (!DigitalInputGetIsActive(args->gpio)) {
-            vTaskDelay(pdMS_TO_TICKS(KEY_TASK_DELAY));
-        }
-
-        pressKey = xTaskGetTickCount();
-        xLastWakeTime = pressKey;
-
-        while (DigitalInputGetIsActive(args->gpio)) {
-            vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(10));
+        vTaskDelay(pdMS_TO_TICKS(KEY_SCAN_PERIOD_MS));
+        DigitalGroupRead(args->keys, &keys); /**< Todas las teclas con una sola lectura del puerto */
 
-            if (xTaskGetTickCount() - pressKey >= pdMS_TO_TICKS(3000)) {
-                xEventGroupSetBits(args->event_group, args->event_bit);
+        events = keys.activated & ~args->long_press;
+        for (index = 0; index < 8; index++) {
+            if (!(args->long_press & (1 << index))) {
+                continue;
             }
+            if (!(keys.active & (1 << index))) {
+                held[index] = 0;
+            } else if (held[index] < KEY_LONG_PRESS_MS / KEY_SCAN_PERIOD_MS) {
+                held[index]++;
+                if (held[index] == KEY_LONG_PRESS_MS / KEY_SCAN_PERIOD_MS) {
+                    events |= (1 << index); /**< Una sola vez por pulsación */
+                }
+            }
+        }
+        if (events) {
+            TraceRecord(TRACE_EVENT_KEY, events & args->long_press, events);
+            xEventGroupSetBits(args->event_group, events);
         }
     }
 }
@@ -46,9 +46,15 @@
 #include "key.h"
 #include "timeMEF.h"
 #include "display.h"
+#include "monitor.h"
+#include "power.h"
+#include "settings.h"
 #include "Mybsp.h"
 #include "chip.h"
 #include "clock.h"
+#include "console.h"
+#include "sync.h"
+#include "trace.h"
 #include <stdbool.h>
 
 /* === Macros definitions ====================================================================== */
@@ -59,6 +65,8 @@
 #define TECLA_DECREMENT KEY_EVENT_KEY_3
 #define TECLA_SET_TIME  KEY_EVENT_KEY_4
 #define TECLA_SET_ALARM KEY_EVENT_KEY_5
+#define EVENTO_TIMER    KEY_EVENT_KEY_6 // Bit libre del grupo, fin de la cuenta regresiva
+#define EVENTO_TIMEOUT  KEY_EVENT_KEY_7 // Bit libre del grupo, vencimiento del tiempo de un ajuste
 
 /* === Private data type declarations ========================================================== */
 
@@ -66,6 +74,12 @@
 
 /* === Private function declarations =========================================================== */
 
+static void * TaskArgs(size_t size);
+
+static void ShowRestoredTime(void);
+
+static void BootTask(void * pointer);
+
 /* === Public variable definitions ============================================================= */
 
 static const struct board_s * board = NULL;
@@ -75,66 +89,62 @@ static struct clock_s * clock = NULL;
 
 /* === Private function implementation ========================================================= */
 
-/* === Public function implementation ========================================================= */
+//! Reserva los argumentos de una tarea, que se usan mientras el equipo esté encendido y nunca se liberan
+static void * TaskArgs(size_t size) {
+    void * args = malloc(size);
 
-int main(void) {
-    EventGroupHandle_t keys_events;
-    BaseType_t result;
+    configASSERT(args != NULL); // Sin memoria durante el arranque el equipo no puede funcionar
+    return args;
+}
 
-    BoardSetup();
-    BoardSetup();
+static void ShowRestoredTime(void) {
+    settings_t settings;
+    clock_time_t hora;
+
+    if (SettingsLoad(&settings)) {
+        if (settings.alarm_valid) {
+            ClockSetAlarm(clock, &settings.alarm);
+            ClockSetAlarmDays(clock, settings.alarm_days);
+        }
+        if (settings.date_valid) {
+            ClockSetDate(clock, &settings.date);
+        }
+        if (settings.time_valid) {
+            ClockSetTime(clock, &settings.time); // Última hora conocida antes del corte
+        }
+        ScreenSetBrightness(board->screen, settings.brightness);
+        SyncSetUtcOffset(settings.utc_offset); // Cero en los registros anteriores a la versión 2, la hora UTC
+    }
 
-    keys_events = xEventGroupCreate();
+    // La primera imagen queda lista antes de arrancar el planificador, parpadeando si la hora no es válida
+    if (!ClockGetTime(clock, &hora)) {
+        DisplayFlashDigits(board->screen, 0, 3, 100);
+    }
+    ScreenWriteBCD(board->screen, &hora.bcd[2], 4);
+}
 
-    board = BoardCreate();
-    clock = ClockCreate();
+static void BootTask(void * pointer) {
+    EventGroupHandle_t keys_events = pointer;
+    BaseType_t result = pdPASS;
+
+    // Con menor prioridad que el refresco, esta tarea recién corre cuando la pantalla ya mostró la hora
+    MonitorBootMark(MONITOR_BOOT_FIRST_DIGIT);
 
+    BoardCreatePeripherals();
     DigitalOutputDeactivate(board->led_R);
+    MonitorBootMark(MONITOR_BOOT_PERIPHERALS);
 
-    if (keys_events) {
-        key_task_args_t key_args = malloc(sizeof(*key_args));
-        key_args->event_group = keys_events;
-        key_args->event_bit = TECLA_ACCEPT;
-        key_args->gpio = board->accept;
-        result = xTaskCreate(KeyTask, "KeyAccept", KEY_TASK_STACK_SIZE, key_args, tskIDLE_PRIORITY + 1, NULL);
-    }
     if (result == pdPASS) {
-        key_task_args_t key_args = malloc(sizeof(*key_args));
+        // Una sola tarea explora todas las teclas, el orden del grupo coincide con los bits TECLA_*
+        key_task_args_t key_args = TaskArgs(sizeof(*key_args));
         key_args->event_group = keys_events;
-        key_args->event_bit = TECLA_CANCEL;
-        key_args->gpio = board->cancel;
-        result = xTaskCreate(KeyTask, "KeyCancel", KEY_TASK_STACK_SIZE, key_args, tskIDLE_PRIORITY + 1, NULL);
+        key_args->keys = board->keys;
+        key_args->long_press = TECLA_SET_TIME | TECLA_SET_ALARM;
+        key_args->debounce_ms = KEY_DEBOUNCE_MS;
+        result = xTaskCreate(KeyScanTask, "Keys", KEY_TASK_STACK_SIZE, key_args, tskIDLE_PRIORITY + 1, NULL);
     }
     if (result == pdPASS) {
-        key_task_args_t key_args = malloc(sizeof(*key_args));
-        key_args->event_group = keys_events;
-        key_args->event_bit = TECLA_INCREMENT;
-        key_args->gpio = board->increment;
-        result = xTaskCreate(KeyTask, "KeyIncrement", KEY_TASK_STACK_SIZE, key_args, tskIDLE_PRIORITY + 1, NULL);
-    }
-    if (result == pdPASS) {
-        key_task_args_t key_args = malloc(sizeof(*key_args));
-        key_args->event_group = keys_events;
-        key_args->event_bit = TECLA_DECREMENT;
-        key_args->gpio = board->decrement;
-        result = xTaskCreate(KeyTask, "KeyDecrement", KEY_TASK_STACK_SIZE, key_args, tskIDLE_PRIORITY + 1, NULL);
-    }
-    if (result == pdPASS) {
-        key_task_args_t key_args = malloc(sizeof(*key_args));
-        key_args->event_group = keys_events;
-        key_args->event_bit = TECLA_SET_TIME;
-        key_args->gpio = board->set_time;
-        result = xTaskCreate(LargeKeyTask, "KeySetTime", KEY_TASK_STACK_SIZE, key_args, tskIDLE_PRIORITY + 1, NULL);
-    }
-    if (result == pdPASS) {
-        key_task_args_t key_args = malloc(sizeof(*key_args));
-        key_args->event_group = keys_events;
-        key_args->event_bit = TECLA_SET_ALARM;
-        key_args->gpio = board->set_alarm;
-        result = xTaskCreate(LargeKeyTask, "KeySetAlarm", KEY_TASK_STACK_SIZE, key_args, tskIDLE_PRIORITY + 1, NULL);
-    }
-    if (result == pdPASS) {
-        time_task_args_t time_args = malloc(sizeof(*time_args));
+        time_task_args_t time_args = TaskArgs(sizeof(*time_args));
         time_args->event_group = keys_events;
         time_args->accept = TECLA_ACCEPT;
         time_args->cancel = TECLA_CANCEL;
@@ -142,16 +152,65 @@ int main(void) {
         time_args->decrement = TECLA_DECREMENT;
         time_args->set_time = TECLA_SET_TIME;
         time_args->set_alarm = TECLA_SET_ALARM;
+        time_args->timer_expired = EVENTO_TIMER;
+        time_args->timeout = EVENTO_TIMEOUT;
         time_args->board = board;
         time_args->clock = clock;
         result = xTaskCreate(MEFTask, "MEF", 2 * configMINIMAL_STACK_SIZE, time_args, tskIDLE_PRIORITY + 3, NULL);
     }
     if (result == pdPASS) {
-        result = xTaskCreate(RefreshScreenTask, "RefreshScreen", configMINIMAL_STACK_SIZE, board->screen,
-                             tskIDLE_PRIORITY + 2, NULL);
+        // La consola nunca espera al puerto serie, con la menor prioridad solo usa el tiempo libre
+        console_task_args_t console_args = TaskArgs(sizeof(*console_args));
+        console_args->port = board->console;
+        console_args->clock = clock;
+        result = xTaskCreate(ConsoleTask, "Console", CONSOLE_TASK_STACK_SIZE, console_args, tskIDLE_PRIORITY + 1, NULL);
+    }
+    if (result == pdPASS) {
+        // La demora hasta atender un mensaje no afecta la fase cuando hay pulso, se mide su edad al aplicarlo
+        sync_task_args_t sync_args = TaskArgs(sizeof(*sync_args));
+        sync_args->port = board->sync;
+        sync_args->clock = clock;
+        result = xTaskCreate(SyncTask, "Sync", SYNC_TASK_STACK_SIZE, sync_args, tskIDLE_PRIORITY + 2, NULL);
     }
     if (result == pdPASS) {
-        result = xTaskCreate(TickTask, "Ticks", configMINIMAL_STACK_SIZE, clock, tskIDLE_PRIORITY + 4, NULL);
+        result = xTaskCreate(MonitorTask, "Monitor", MONITOR_TASK_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, NULL);
+    }
+    configASSERT(result == pdPASS);
+    MonitorBootMark(MONITOR_BOOT_DONE);
+
+    vTaskDelete(NULL);
+}
+
+/* === Public function implementation ========================================================= */
+
+int main(void) {
+    EventGroupHandle_t keys_events;
+    BaseType_t result;
+
+    BoardSetup();
+    TraceInit();        // Antes de PowerInit, que registra la frecuencia del núcleo
+    MonitorTimerInit(); // Base de tiempo para registrar las etapas del arranque
+    PowerInit(); // Arranca en el modo activo, la MEF baja la frecuencia al mostrar solamente la hora
+    MonitorBootMark(MONITOR_BOOT_SETUP);
+
+    // Primero la pantalla y el reloj, el resto de la placa se inicializa en la tarea de arranque
+    board = BoardCreate();
+    MonitorBootMark(MONITOR_BOOT_DISPLAY);
+
+    clock = ClockCreate();
+    SettingsInit(board->settings); // Recuperar la configuración guardada antes del último corte
+    ShowRestoredTime();
+    MonitorBootMark(MONITOR_BOOT_CLOCK);
+
+    keys_events = xEventGroupCreate();
+
+    // Una sola tarea de 1 kHz avanza el reloj y refresca la pantalla, en ese orden
+    service_args_t service_args = TaskArgs(sizeof(*service_args));
+    service_args->clock = clock;
+    service_args->screen = board->screen;
+    result = xTaskCreate(ServiceTask, "Service", configMINIMAL_STACK_SIZE, service_args, tskIDLE_PRIORITY + 4, NULL);
+    if ((result == pdPASS) && keys_events) {
+        result = xTaskCreate(BootTask, "Boot", 2 * configMINIMAL_STACK_SIZE, keys_events, tskIDLE_PRIORITY + 1, NULL);
     }
 
     vTaskStartScheduler();
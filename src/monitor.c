@@ -0,0 +1,179 @@
+/*********************************************************************************************************************
+Copyright (c) 2025, Martín Fernando Gareca del autor <mfgareca36@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*********************************************************************************************************************/
+
+/** @file monitor.c
+ ** @brief Implementación de funciones y macros para el monitoreo de tareas, pilas y memoria del sistema.
+ **/
+
+/* === Headers files inclusions ==================================================================================== */
+
+#include "monitor.h"
+#include "task.h"
+#include "power.h"
+#include "chip.h"
+#include <stdbool.h>
+#include <string.h>
+
+/* === Macros definitions ========================================================================================== */
+
+#define MONITOR_TIMER     LPC_TIMER3    // Temporizador libre usado como base de tiempo de las estadísticas
+#define MONITOR_TIMER_CLK CLK_MX_TIMER3 // Reloj del temporizador usado como base de tiempo
+
+/* === Private data type declarations ============================================================================== */
+
+/* === Private function declarations =============================================================================== */
+
+static void ClockChanged(void);
+
+/* === Private variable definitions ================================================================================ */
+
+static volatile uint32_t switches[MONITOR_MAX_TASKS]; /**< Entradas en ejecución acumuladas por número de tarea */
+
+static uint32_t last_switches[MONITOR_MAX_TASKS]; /**< Entradas en ejecución al momento del reporte anterior */
+
+static uint32_t last_run_time[MONITOR_MAX_TASKS]; /**< Tiempo de ejecución al momento del reporte anterior */
+
+static uint32_t last_total_time; /**< Valor del contador al momento del reporte anterior */
+
+static TaskStatus_t status[MONITOR_MAX_TASKS]; /**< Estado de las tareas, estático para no usar la pila */
+
+static monitor_report_t last_report; /**< Último reporte generado, se puede inspeccionar con el depurador */
+
+static bool timer_running = false; /**< Indica si el contador ya fue configurado */
+
+/* === Public variable definitions ================================================================================= */
+
+/* === Private function definitions ================================================================================ */
+
+static void ClockChanged(void) {
+    PowerTimerSetRate(MONITOR_TIMER, MONITOR_TIMER_CLK, MONITOR_TIMER_HZ);
+}
+
+/* === Public function definitions ================================================================================= */
+
+void MonitorTimerInit(void) {
+    int result;
+
+    if (timer_running) {
+        return;
+    }
+    timer_running = true;
+    Chip_TIMER_Init(MONITOR_TIMER);
+    Chip_TIMER_PrescaleSet(MONITOR_TIMER, Chip_Clock_GetRate(MONITOR_TIMER_CLK) / MONITOR_TIMER_HZ - 1);
+    Chip_TIMER_Reset(MONITOR_TIMER);
+    Chip_TIMER_Enable(MONITOR_TIMER);
+    result = PowerAddClockHook(ClockChanged); /**< Las cuentas valen lo mismo en todos los modos de funcionamiento */
+    configASSERT(result == 0);
+    (void)result;
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; /**< Habilitar el contador de ciclos del núcleo */
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+uint32_t MonitorTimerGetCount(void) {
+    return Chip_TIMER_ReadCount(MONITOR_TIMER);
+}
+
+uint32_t MonitorCycleCount(void) {
+    return DWT->CYCCNT;
+}
+
+uint32_t MonitorCyclesToUs(uint32_t cycles) {
+    return cycles / (SystemCoreClock / 1000000);
+}
+
+void MonitorBootMark(monitor_boot_phase_t phase) {
+    if (phase < MONITOR_BOOT_PHASES) {
+        last_report.boot[phase] = MonitorTimerGetCount();
+    }
+}
+
+void MonitorTaskSwitchedIn(uint32_t number) {
+    if (number < MONITOR_MAX_TASKS) {
+        switches[number]++;
+    }
+}
+
+int MonitorUpdate(monitor_report_t * report) {
+    uint32_t total_time;
+    uint32_t elapsed;
+    UBaseType_t count;
+    uint8_t number;
+
+    count = uxTaskGetSystemState(status, MONITOR_MAX_TASKS, &total_time);
+    if (count == 0) {
+        return -1; /**< Hay más tareas que lugares en el arreglo de estado */
+    }
+
+    elapsed = total_time - last_total_time;
+    last_total_time = total_time;
+
+    last_report.sequence++;
+    last_report.elapsed = elapsed;
+    last_report.task_count = count;
+    for (UBaseType_t i = 0; i < count; i++) {
+        monitor_task_t * task = &last_report.tasks[i];
+        number = status[i].xTaskNumber % MONITOR_MAX_TASKS;
+
+        task->name = status[i].pcTaskName;
+        task->number = status[i].xTaskNumber;
+        task->priority = status[i].uxCurrentPriority;
+        task->stack_free_words = status[i].usStackHighWaterMark;
+        task->switches = switches[number] - last_switches[number];
+        last_switches[number] = switches[number];
+
+        if (elapsed != 0) {
+            task->cpu_permille = ((uint64_t)(status[i].ulRunTimeCounter - last_run_time[number]) * 1000) / elapsed;
+        } else {
+            task->cpu_permille = 0;
+        }
+        last_run_time[number] = status[i].ulRunTimeCounter;
+    }
+
+    last_report.heap_free = xPortGetFreeHeapSize();
+    last_report.heap_minimum_free = xPortGetMinimumEverFreeHeapSize();
+
+    if (report != NULL) {
+        memcpy(report, &last_report, sizeof(monitor_report_t));
+    }
+    return 0;
+}
+
+const monitor_report_t * MonitorGetReport(void) {
+    return &last_report;
+}
+
+void MonitorTask(void * pointer) {
+    TickType_t last_value = xTaskGetTickCount();
+
+    MonitorUpdate(NULL); /**< Descartar lo acumulado durante el arranque */
+    while (1) {
+        xTaskDelayUntil(&last_value, pdMS_TO_TICKS(MONITOR_PERIOD_MS));
+        MonitorUpdate(NULL);
+    }
+}
+
+void vApplicationStackOverflowHook(TaskHandle_t task, char * name) {
+    (void)task;
+    (void)name;
+    configASSERT(0); /**< Detener el sistema para que el depurador muestre la tarea que desbordó su pila */
+}
+
+/* === End of documentation ======================================================================================== */
@@ -0,0 +1,224 @@
+/*********************************************************************************************************************
+Copyright (c) 2025, Martín Fernando Gareca del autor <mfgareca36@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*********************************************************************************************************************/
+
+/** @file power.c
+ ** @brief Implementación del bajo consumo: reposo en la tarea inactiva y frecuencia según el modo
+ **/
+
+/* === Headers files inclusions ==================================================================================== */
+
+#include "power.h"
+#include "monitor.h"
+#include "trace.h"
+#include "task.h"
+#include "chip.h"
+#include <stdbool.h>
+#include <string.h>
+
+/* === Macros definitions ========================================================================================== */
+
+#define POWER_DIM_IRQ    TIMER2_IRQn // Interrupción del temporizador de brillo de la pantalla
+#define POWER_DMA_IRQ    DMA_IRQn    // Interrupción del DMA que envía la trama de la pantalla serie
+#define POWER_BUZZER_IRQ TIMER0_IRQn // Interrupción del temporizador de notas del zumbador
+#define POWER_DIVIDER    CLK_IDIV_C  // Divisor del PLL principal usado en el modo de solo pantalla
+#define POWER_DIVIDER_IN CLKIN_IDIVC // Entrada de reloj base que corresponde a ese divisor
+#define POWER_STEP       CLK_IDIV_D  // Divisor del PLL principal usado como paso intermedio al subir la frecuencia
+#define POWER_STEP_IN    CLKIN_IDIVD // Entrada de reloj base que corresponde a ese divisor
+#define POWER_STEP_DIV   2           // 204 MHz / 2 = 102 MHz, dentro del rango de 90 a 110 MHz del paso intermedio
+
+/* === Private data type declarations ============================================================================== */
+
+/* === Private function declarations =============================================================================== */
+
+static power_wake_t WakeSource(void);
+
+static void SetCoreClock(CHIP_CGU_CLKIN_T input);
+
+static void ApplyMode(power_mode_t mode);
+
+/* === Private variable definitions ================================================================================ */
+
+static power_stats_t stats; /**< Contadores, se pueden inspeccionar con el depurador */
+
+static power_mode_t current_mode = POWER_MODE_ACTIVE; /**< Modo aplicado, solo lo cambia la interrupción del tick */
+
+static volatile power_mode_t requested_mode = POWER_MODE_ACTIVE; /**< Modo pedido, se aplica en el próximo tick */
+
+static bool stepping = false; /**< El núcleo está en el paso intermedio hacia el PLL principal */
+
+static volatile uint8_t holds = 0; /**< Pedidos de mantener la frecuencia actual, los cambios esperan a que terminen */
+
+static uint32_t mode_start; /**< Instante en que se aplicó el modo actual, en cuentas del contador del monitor */
+
+static power_clock_hook_t hooks[POWER_MAX_HOOKS];
+
+static volatile uint8_t hooks_count = 0;
+
+/* === Public variable definitions ================================================================================= */
+
+/* === Private function definitions ================================================================================ */
+
+static power_wake_t WakeSource(void) {
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) {
+        return POWER_WAKE_TICK;
+    }
+    if (NVIC_GetPendingIRQ(POWER_DIM_IRQ) || NVIC_GetPendingIRQ(POWER_DMA_IRQ)) {
+        return POWER_WAKE_DISPLAY;
+    }
+    if (NVIC_GetPendingIRQ(POWER_BUZZER_IRQ)) {
+        return POWER_WAKE_BUZZER;
+    }
+    return POWER_WAKE_OTHER;
+}
+
+static void SetCoreClock(CHIP_CGU_CLKIN_T input) {
+    // La conmutación del reloj base no tiene glitches y el PLL sigue enganchado, no hay que esperar nada
+    Chip_Clock_SetBaseClock(CLK_BASE_MX, input, true, false);
+    SystemCoreClockUpdate();
+    TraceClock(SystemCoreClock);
+
+    SysTick->LOAD = SystemCoreClock / configTICK_RATE_HZ - 1;
+    SysTick->VAL = 0; /**< El tick recién se recargó, el período en curso arranca de nuevo con la nueva frecuencia */
+
+    for (uint8_t i = 0; i < hooks_count; i++) {
+        hooks[i]();
+    }
+}
+
+static void ApplyMode(power_mode_t mode) {
+    uint32_t now;
+
+    // El manual pide pasar al menos 50 us por una frecuencia de 90 a 110 MHz antes de llevar el núcleo por encima
+    // de 110 MHz, así el consumo no salta de golpe. El paso dura un tick y el cambio termina en el siguiente
+    if ((mode == POWER_MODE_ACTIVE) && (current_mode != POWER_MODE_ACTIVE) && !stepping) {
+        SetCoreClock(POWER_STEP_IN);
+        stepping = true;
+        return;
+    }
+    stepping = false;
+
+    now = MonitorTimerGetCount();
+    stats.mode_time[current_mode] += now - mode_start;
+    mode_start = now;
+
+    SetCoreClock((mode == POWER_MODE_DISPLAY) ? POWER_DIVIDER_IN : CLKIN_MAINPLL);
+    current_mode = mode;
+    stats.switches++;
+}
+
+/* === Public function definitions ================================================================================= */
+
+void PowerIdle(void) {
+    uint32_t start;
+    uint32_t elapsed;
+
+    // Con las interrupciones enmascaradas WFI igual despierta, pero la interrupción queda pendiente hasta
+    // habilitarlas, lo que permite ver qué la produjo antes de que se atienda
+    __disable_irq();
+    SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+    start = MonitorTimerGetCount();
+    __DSB();
+    __WFI();
+    elapsed = MonitorTimerGetCount() - start;
+    stats.sleep_time += elapsed;
+    stats.mode_sleep[current_mode] += elapsed;
+    stats.wakes[WakeSource()]++;
+    stats.sleeps++;
+    __enable_irq();
+    __ISB();
+}
+
+void PowerGetStats(power_stats_t * result) {
+    taskENTER_CRITICAL();
+    memcpy(result, &stats, sizeof(stats));
+    result->mode_time[current_mode] += MonitorTimerGetCount() - mode_start;
+    taskEXIT_CRITICAL();
+}
+
+void PowerInit(void) {
+    Chip_Clock_SetDivider(POWER_DIVIDER, CLKIN_MAINPLL, POWER_DISPLAY_DIVIDER);
+    Chip_Clock_SetDivider(POWER_STEP, CLKIN_MAINPLL, POWER_STEP_DIV);
+    mode_start = MonitorTimerGetCount();
+    TraceClock(SystemCoreClock);
+}
+
+int PowerAddClockHook(power_clock_hook_t hook) {
+    if ((hook == NULL) || (hooks_count >= POWER_MAX_HOOKS)) {
+        return -1;
+    }
+    hooks[hooks_count] = hook;
+    hooks_count++; /**< La entrada queda completa antes de que el tick la vea */
+    return 0;
+}
+
+void PowerSetMode(power_mode_t mode) {
+    if (mode < POWER_MODES) {
+        requested_mode = mode;
+    }
+}
+
+void PowerHoldMode(void) {
+    taskENTER_CRITICAL();
+    holds++;
+    taskEXIT_CRITICAL();
+}
+
+void PowerReleaseMode(void) {
+    taskENTER_CRITICAL();
+    if (holds > 0) {
+        holds--;
+    }
+    taskEXIT_CRITICAL();
+}
+
+power_mode_t PowerGetMode(void) {
+    return current_mode;
+}
+
+uint16_t PowerHeadroom(power_mode_t mode) {
+    power_stats_t snapshot;
+
+    if (mode >= POWER_MODES) {
+        return 0;
+    }
+    PowerGetStats(&snapshot);
+    if (snapshot.mode_time[mode] == 0) {
+        return 0;
+    }
+    return (snapshot.mode_sleep[mode] * 1000) / snapshot.mode_time[mode];
+}
+
+void PowerTimerSetRate(LPC_TIMER_T * timer, CHIP_CCU_CLK_T clock, uint32_t hz) {
+    Chip_TIMER_PrescaleSet(timer, Chip_Clock_GetRate(clock) / hz - 1);
+    if (timer->PC > timer->PR) {
+        timer->PC = timer->PR;
+    }
+}
+
+void vApplicationIdleHook(void) {
+    PowerIdle();
+}
+
+void vApplicationTickHook(void) {
+    if ((holds == 0) && ((requested_mode != current_mode) || stepping)) {
+        ApplyMode(requested_mode);
+    }
+}
+
+/* === End of documentation ======================================================================================== */
@@ -24,48 +24,136 @@ SPDX-License-Identifier: MIT
 /* === Headers files inclusions ==================================================================================== */
 
 #include "screen.h"
+#include "ramfunc.h"
+#include "trace.h"
 
 /* === Macros definitions ========================================================================================== */
 
-#ifndef SCREEN_MAX_DIGITS
-#define SCREEN_MAX_DIGITS 8 // Número máximo de dígitos soportados por la pantalla
-#endif
+#define GLYPH_0 (SEGMENT_A | SEGMENT_B | SEGMENT_C | SEGMENT_D | SEGMENT_E | SEGMENT_F)
+#define GLYPH_1 (SEGMENT_B | SEGMENT_C)
+#define GLYPH_2 (SEGMENT_A | SEGMENT_B | SEGMENT_D | SEGMENT_E | SEGMENT_G)
+#define GLYPH_3 (SEGMENT_A | SEGMENT_B | SEGMENT_C | SEGMENT_D | SEGMENT_G)
+#define GLYPH_4 (SEGMENT_B | SEGMENT_C | SEGMENT_F | SEGMENT_G)
+#define GLYPH_5 (SEGMENT_A | SEGMENT_C | SEGMENT_D | SEGMENT_F | SEGMENT_G)
+#define GLYPH_6 (SEGMENT_A | SEGMENT_C | SEGMENT_D | SEGMENT_E | SEGMENT_F | SEGMENT_G)
+#define GLYPH_7 (SEGMENT_A | SEGMENT_B | SEGMENT_C)
+#define GLYPH_8 (SEGMENT_A | SEGMENT_B | SEGMENT_C | SEGMENT_D | SEGMENT_E | SEGMENT_F | SEGMENT_G)
+#define GLYPH_9 (SEGMENT_A | SEGMENT_B | SEGMENT_C | SEGMENT_D | SEGMENT_F | SEGMENT_G)
+#define GLYPH_A (SEGMENT_A | SEGMENT_B | SEGMENT_C | SEGMENT_E | SEGMENT_F | SEGMENT_G)
+#define GLYPH_B (SEGMENT_C | SEGMENT_D | SEGMENT_E | SEGMENT_F | SEGMENT_G)
+#define GLYPH_C (SEGMENT_A | SEGMENT_D | SEGMENT_E | SEGMENT_F)
+#define GLYPH_D (SEGMENT_B | SEGMENT_C | SEGMENT_D | SEGMENT_E | SEGMENT_G)
+#define GLYPH_E (SEGMENT_A | SEGMENT_D | SEGMENT_E | SEGMENT_F | SEGMENT_G)
+#define GLYPH_F (SEGMENT_A | SEGMENT_E | SEGMENT_F | SEGMENT_G)
+
+#define DIGIT_FLASH (1 << 0) // El dígito parpadea
+#define DOT_ON      (1 << 1) // El punto decimal está encendido
+#define DOT_FLASH   (1 << 2) // El punto decimal parpadea
+
+//! Entrada de la tabla de caracteres para una letra que se muestra igual en mayúscula y en minúscula
+#define LETTER(upper, segments) [upper] = (segments), [(upper) + ('a' - 'A')] = (segments)
 
 /* === Private data type declarations ============================================================================== */
 
+//! Estado de un dígito de la pantalla
+struct screen_digit_s {
+    uint8_t value; /**< Segmentos a mostrar */
+    uint8_t flags; /**< Combinación de DIGIT_FLASH, DOT_ON y DOT_FLASH */
+};
+
 struct screen_s {
     uint8_t digits;        /**< Número de dígitos en la pantalla */
     uint8_t current_digit; /**< Dígito actual a mostrar */
 
-    uint8_t flashing_from;               /**< Dígito desde el cual comenzar a parpadear */
-    uint8_t flashing_to;                 /**< Dígito hasta el cual parpadear */
-    uint16_t flashing_count_display;     /**< Contador para el parpadeo de los displays */
-    uint16_t flashing_frequency_display; /**< Factor de división para el parpadeo de los displays */
+    uint16_t flash_count;  /**< Fase del parpadeo, compartida por todos los dígitos y puntos */
+    uint16_t flash_period; /**< Barridos completos de un ciclo de parpadeo, 0 si no hay parpadeo */
+    uint8_t flash_hide;    /**< Banderas que se ocultan en la fase actual del parpadeo */
 
-    bool dot_turning_on[SCREEN_MAX_DIGITS];       /**< Indica si el punto decimal está encendido */
-    bool dot_flashing_enabled[SCREEN_MAX_DIGITS]; /**< Indica si el punto decimal está habilitado para parpadear */
+    screen_driver_t driver; /**< Estructura con funciones de control de pantalla */
+    screen_t next;          /**< Siguiente pantalla de la cadena, se refresca en el mismo intervalo */
 
-    screen_driver_t driver;           /**< Estructura con funciones de control de pantalla */
-    uint8_t value[SCREEN_MAX_DIGITS]; /**< Valores a mostrar */
+    uint8_t brightness;        /**< Nivel de brillo actual */
+    uint8_t brightness_target; /**< Nivel de brillo al que se dirige la transición en curso */
+    uint16_t fade_count;       /**< Contador de barridos para la transición de brillo */
+    uint16_t fade_divisor;     /**< Barridos completos que dura cada paso de la transición de brillo */
 
-    uint16_t
-        flashing_frequency_dot[SCREEN_MAX_DIGITS];  /**< Factor de división para el parpadeo de los puntos decimales */
-    uint16_t flashing_count_dot[SCREEN_MAX_DIGITS]; /**< Contador para el parpadeo de los puntos decimales */
+    uint8_t scroll_length;                 /**< Cuadros de la marquesina en curso, 0 si no hay marquesina */
+    uint8_t scroll_offset;                 /**< Posición del primer dígito dentro de la marquesina */
+    uint16_t scroll_count;                 /**< Contador de barridos para avanzar la marquesina */
+    uint16_t scroll_divisor;               /**< Barridos completos que dura cada cuadro de la marquesina */
+    uint8_t scroll[SCREEN_SCROLL_MAX + 1]; /**< Imágenes del texto ya convertidas, seguidas de un espacio */
+
+    struct screen_digit_s digit[]; /**< Estado de cada dígito, se reserva junto con la pantalla */
 };
 
 /* === Private function declarations =============================================================================== */
 
-static const uint8_t IMAGES[10] = {
-    SEGMENT_A | SEGMENT_B | SEGMENT_C | SEGMENT_D | SEGMENT_E | SEGMENT_F,             /**< 0 */
-    SEGMENT_B | SEGMENT_C,                                                             /**< 1 */
-    SEGMENT_A | SEGMENT_B | SEGMENT_D | SEGMENT_E | SEGMENT_G,                         /**< 2 */
-    SEGMENT_A | SEGMENT_B | SEGMENT_C | SEGMENT_D | SEGMENT_G,                         /**< 3 */
-    SEGMENT_B | SEGMENT_C | SEGMENT_F | SEGMENT_G,                                     /**< 4 */
-    SEGMENT_A | SEGMENT_C | SEGMENT_D | SEGMENT_F | SEGMENT_G,                         /**< 5 */
-    SEGMENT_A | SEGMENT_C | SEGMENT_D | SEGMENT_E | SEGMENT_F | SEGMENT_G,             /**< 6 */
-    SEGMENT_A | SEGMENT_B | SEGMENT_C,                                                 /**< 7 */
-    SEGMENT_A | SEGMENT_B | SEGMENT_C | SEGMENT_D | SEGMENT_E | SEGMENT_F | SEGMENT_G, /**< 8 */
-    SEGMENT_A | SEGMENT_B | SEGMENT_C | SEGMENT_D | SEGMENT_F | SEGMENT_G              /**< 9 */
+/**
+ * @brief Función para obtener la imagen de un carácter.
+ * @param character Carácter que se quiere mostrar.
+ * @return Segmentos del carácter, los que están fuera de la tabla ASCII se muestran apagados.
+ */
+static uint8_t ScreenGlyph(char character);
+
+//! Imagen de cada valor BCD, incluyendo los dígitos hexadecimales
+static const uint8_t IMAGES[16] = {
+    GLYPH_0, GLYPH_1, GLYPH_2, GLYPH_3, GLYPH_4, GLYPH_5, GLYPH_6, GLYPH_7,
+    GLYPH_8, GLYPH_9, GLYPH_A, GLYPH_B, GLYPH_C, GLYPH_D, GLYPH_E, GLYPH_F,
+};
+
+//! Imagen de cada carácter ASCII, los que no se pueden representar quedan en cero y se muestran apagados
+static const uint8_t FONT[128] = {
+    ['0'] = GLYPH_0,
+    ['1'] = GLYPH_1,
+    ['2'] = GLYPH_2,
+    ['3'] = GLYPH_3,
+    ['4'] = GLYPH_4,
+    ['5'] = GLYPH_5,
+    ['6'] = GLYPH_6,
+    ['7'] = GLYPH_7,
+    ['8'] = GLYPH_8,
+    ['9'] = GLYPH_9,
+    LETTER('A', GLYPH_A),
+    LETTER('B', GLYPH_B),
+    ['C'] = GLYPH_C,
+    ['c'] = SEGMENT_D | SEGMENT_E | SEGMENT_G,
+    LETTER('D', GLYPH_D),
+    LETTER('E', GLYPH_E),
+    LETTER('F', GLYPH_F),
+    LETTER('G', SEGMENT_A | SEGMENT_C | SEGMENT_D | SEGMENT_E | SEGMENT_F),
+    ['H'] = SEGMENT_B | SEGMENT_C | SEGMENT_E | SEGMENT_F | SEGMENT_G,
+    ['h'] = SEGMENT_C | SEGMENT_E | SEGMENT_F | SEGMENT_G,
+    ['I'] = SEGMENT_E | SEGMENT_F,
+    ['i'] = SEGMENT_C,
+    LETTER('J', SEGMENT_B | SEGMENT_C | SEGMENT_D | SEGMENT_E),
+    LETTER('L', SEGMENT_D | SEGMENT_E | SEGMENT_F),
+    LETTER('N', SEGMENT_C | SEGMENT_E | SEGMENT_G),
+    ['O'] = GLYPH_0,
+    ['o'] = SEGMENT_C | SEGMENT_D | SEGMENT_E | SEGMENT_G,
+    LETTER('P', SEGMENT_A | SEGMENT_B | SEGMENT_E | SEGMENT_F | SEGMENT_G),
+    LETTER('Q', SEGMENT_A | SEGMENT_B | SEGMENT_C | SEGMENT_F | SEGMENT_G),
+    LETTER('R', SEGMENT_E | SEGMENT_G),
+    LETTER('S', GLYPH_5),
+    LETTER('T', SEGMENT_D | SEGMENT_E | SEGMENT_F | SEGMENT_G),
+    ['U'] = SEGMENT_B | SEGMENT_C | SEGMENT_D | SEGMENT_E | SEGMENT_F,
+    ['u'] = SEGMENT_C | SEGMENT_D | SEGMENT_E,
+    LETTER('Y', SEGMENT_B | SEGMENT_C | SEGMENT_D | SEGMENT_F | SEGMENT_G),
+    LETTER('Z', GLYPH_2),
+    ['-'] = SEGMENT_G,
+    ['_'] = SEGMENT_D,
+    ['='] = SEGMENT_D | SEGMENT_G,
+    ['\''] = SEGMENT_F,
+    ['"'] = SEGMENT_B | SEGMENT_F,
+    ['*'] = SEGMENT_A | SEGMENT_B | SEGMENT_F | SEGMENT_G, /**< Símbolo de grados */
+    ['?'] = SEGMENT_A | SEGMENT_B | SEGMENT_E | SEGMENT_G,
+    ['['] = SEGMENT_A | SEGMENT_D | SEGMENT_E | SEGMENT_F,
+    [']'] = SEGMENT_A | SEGMENT_B | SEGMENT_C | SEGMENT_D,
+};
+
+/**< Fracción del intervalo de refresco (en 1/256) que el dígito permanece encendido para cada nivel de brillo,
+     con corrección gamma 2.2 para que los pasos se perciban uniformes */
+__ramdata static const uint8_t BRIGHTNESS_DUTY[SCREEN_BRIGHTNESS_MAX] = {
+    1, 3, 6, 12, 20, 30, 42, 56, 72, 91, 112, 136, 162, 191, 222,
 };
 
 /* === Private variable definitions ================================================================================ */
@@ -74,96 +162,211 @@ static const uint8_t IMAGES[10] = {
 
 /* === Private function definitions ================================================================================ */
 
+static uint8_t ScreenGlyph(char character) {
+    uint8_t index = (uint8_t)character;
+
+    return (index < sizeof(FONT)) ? FONT[index] : 0;
+}
+
+/**
+ * @brief Función para refrescar una sola pantalla de la cadena.
+ * @param self Puntero al descriptor de la pantalla con la que se quiere operar.
+ */
+__ramfunc static void ScreenRefreshPanel(screen_t self) {
+    uint8_t segments;
+    uint8_t index;
+    uint8_t flags;
+
+    self->driver->DigitsTurnOff();                                  /**< Apagar todos los dígitos */
+    self->current_digit = (self->current_digit + 1) % self->digits; /**< Avanzar al siguiente dígito */
+
+    if (self->scroll_length != 0) {
+        if (self->current_digit == 0) {
+            self->scroll_count++;
+            if (self->scroll_count >= self->scroll_divisor) {
+                self->scroll_count = 0;
+                self->scroll_offset++; /**< Avanzar un cuadro de la marquesina */
+                if (self->scroll_offset >= self->scroll_length) {
+                    self->scroll_offset = 0;
+                }
+            }
+        }
+        index = self->scroll_offset + self->current_digit;
+        while (index >= self->scroll_length) {
+            index -= self->scroll_length; /**< La marquesina es circular */
+        }
+        segments = self->scroll[index];
+    } else {
+        segments = self->digit[self->current_digit].value;
+    }
+    if ((self->current_digit == 0) && (self->flash_period != 0)) {
+        self->flash_count++; /**< Un solo contador de fase por barrido para dígitos y puntos */
+        if (self->flash_count >= self->flash_period) {
+            self->flash_count = 0;
+        }
+        self->flash_hide = (self->flash_count < (self->flash_period / 2)) ? (DIGIT_FLASH | DOT_FLASH) : 0;
+    }
+
+    flags = self->digit[self->current_digit].flags;
+    if (flags & self->flash_hide & DIGIT_FLASH) {
+        segments = 0; /**< Apagar segmentos */
+    }
+    segments &= ~SEGMENT_P;
+    if ((flags & DOT_ON) && !(flags & self->flash_hide & DOT_FLASH)) {
+        segments |= SEGMENT_P; /**< Encender el punto decimal */
+    }
+
+    if ((self->brightness != self->brightness_target) && (self->current_digit == 0)) {
+        self->fade_count++;
+        if (self->fade_count >= self->fade_divisor) {
+            self->fade_count = 0;
+            if (self->brightness < self->brightness_target) {
+                self->brightness++; /**< Avanzar un paso hacia el brillo final */
+            } else {
+                self->brightness--;
+            }
+        }
+    }
+
+    self->driver->SegmentsUpdate(segments);         /**< Actualizar segmentos del dígito actual */
+    self->driver->DigitTurnOn(self->current_digit); /**< Encender el dígito actual */
+    if (self->brightness < SCREEN_BRIGHTNESS_MAX) {
+        self->driver->DigitDim(BRIGHTNESS_DUTY[self->brightness]); /**< Programar el apagado anticipado del dígito */
+    }
+}
+
 /* === Public function definitions ================================================================================= */
 
 screen_t ScreenCreate(uint8_t digits, screen_driver_t driver) {
-    /**< Crear una nueva instancia de pantalla */
-    screen_t self = malloc(sizeof(struct screen_s));
-    if (digits > SCREEN_MAX_DIGITS) {
-        digits = SCREEN_MAX_DIGITS; /**< Limitar a máximo de dígitos */
+    screen_t self = NULL;
+
+    if (digits != 0) {
+        /**< Crear una nueva instancia de pantalla con lugar para el estado de todos sus dígitos */
+        self = malloc(sizeof(struct screen_s) + digits * sizeof(struct screen_digit_s));
     }
     if (self != NULL) {
         self->digits = digits;            /**< Inicializar número de dígitos */
         self->driver = driver;            /**< Asignar controlador de pantalla */
+        self->next = NULL;                /**< Pantalla sin otras encadenadas */
         self->current_digit = 0;          /**< Inicializar dígito actual */
-        self->flashing_count_display = 0; /**< Inicializar contador de parpadeo */
-        self->flashing_frequency_display = 0;
-        memset(self->value, 0, sizeof(self->value)); /**< Limpiar valores previos */
-        memset(
-            self->flashing_count_dot, 0,
-            sizeof(self->flashing_count_dot)); /**< Inicializa en cero los contadores de parpadeo de puntos decimales */
-        memset(self->dot_flashing_enabled, false,
-               sizeof(self->dot_flashing_enabled)); /**< Inhabilitar parpadeo de puntos decimales */
+        self->flash_count = 0;            /**< Inicializar contador de parpadeo */
+        self->flash_period = 0;
+        self->flash_hide = 0;
+        self->brightness = SCREEN_BRIGHTNESS_MAX; /**< Brillo máximo, sin atenuación */
+        self->brightness_target = SCREEN_BRIGHTNESS_MAX;
+        self->fade_count = 0;
+        self->fade_divisor = 0;
+        self->scroll_length = 0; /**< Sin marquesina */
+        memset(self->digit, 0, digits * sizeof(struct screen_digit_s)); /**< Limpiar valores y puntos decimales */
     }
     return self;
 }
 
+int ScreenChain(screen_t self, screen_t next) {
+    int result = 0;
+    if ((!self) || (!next) || (next->next != NULL)) {
+        result = -1;
+    } else {
+        while ((self != next) && (self->next != NULL)) {
+            self = self->next; /**< Buscar el final de la cadena */
+        }
+        if (self == next) {
+            result = -1; /**< La pantalla ya forma parte de la cadena */
+        } else {
+            self->next = next;
+        }
+    }
+
+    return result;
+}
+
 void ScreenWriteBCD(screen_t self, uint8_t value[], uint8_t size) {
-    memset(self->value, 0, sizeof(self->value)); /**< Limpiar valores previos */
+    uint16_t packed = 0;
+
+    self->scroll_length = 0; /**< Detener la marquesina */
+    for (uint8_t i = 0; i < self->digits; i++) {
+        self->digit[i].value = 0; /**< Limpiar valores previos */
+    }
     if (size > self->digits) {
         size = self->digits; /**< Limitar al número de dígitos de la pantalla */
     }
 
     for (uint8_t i = 0; i < size; i++) {
-        self->value[size - 1 - i] = IMAGES[value[i + 2]]; /**< Copiar valores a la pantalla */
+        if (value[i] < sizeof(IMAGES)) {
+            self->digit[self->digits - 1 - i].value = IMAGES[value[i]]; /**< Copiar valores alineados a la derecha */
+        }
     }
-}
 
-void ScreenRefresh(screen_t self) {
-    uint8_t segments;
+    for (uint8_t i = 0; (i < size) && (i < 4); i++) {
+        packed |= (value[i] & 0x0F) << (4 * i); /**< Los cuatro primeros dígitos entran en el registro de traza */
+    }
+    TraceRecord(TRACE_EVENT_SCREEN_BCD, size, packed);
+}
 
-    self->driver->DigitsTurnOff();                                  /**< Apagar todos los dígitos */
-    self->current_digit = (self->current_digit + 1) % self->digits; /**< Avanzar al siguiente dígito */
+int ScreenWriteText(screen_t self, const char * text) {
+    uint8_t i;
 
-    segments = self->value[self->current_digit];
-    if (self->flashing_frequency_display != 0) {
-        if (self->current_digit == 0) {
-            self->flashing_count_display = (self->flashing_count_display + 1) % (self->flashing_frequency_display);
-        }
-        if (self->flashing_count_display < (self->flashing_frequency_display / 2)) {
-            if (self->current_digit >= self->flashing_from) {
-                if (self->current_digit <= self->flashing_to) {
-                    segments = 0; /**< Apagar segmentos */
-                }
-            }
-        }
+    if (text == NULL) {
+        return -1;
     }
 
-    segments |= SEGMENT_P; /**< Encender el punto decimal por defecto */
+    self->scroll_length = 0; /**< Detener la marquesina */
+    for (i = 0; (i < self->digits) && (text[i] != '\0'); i++) {
+        self->digit[i].value = ScreenGlyph(text[i]); /**< Copiar valores alineados a la izquierda */
+    }
+    TraceRecord(TRACE_EVENT_SCREEN_TEXT, i, (uint8_t)text[0] | ((i > 1) ? (uint8_t)text[1] << 8 : 0));
+    for (; i < self->digits; i++) {
+        self->digit[i].value = 0; /**< Apagar los dígitos sobrantes */
+    }
+    return 0;
+}
 
-    if (self->flashing_frequency_dot[self->current_digit] != 0) {
-        if (self->current_digit == 0) {
-            for (uint8_t i = 0; i < SCREEN_MAX_DIGITS; i++) {
-                if (self->flashing_frequency_dot[i] != 0) {
-                    self->flashing_count_dot[i] = (self->flashing_count_dot[i] + 1) % (self->flashing_frequency_dot[i]);
-                }
-            }
-        }
+int ScreenScrollText(screen_t self, const char * text, uint16_t divisor) {
+    uint8_t length;
 
-        if ((self->flashing_count_dot[self->current_digit] < (self->flashing_frequency_dot[self->current_digit] / 2)) &&
-            self->dot_flashing_enabled[self->current_digit]) {
-            segments &= ~SEGMENT_P; /**< Apagar puntos */
-        }
+    if ((self == NULL) || (text == NULL) || (divisor == 0)) {
+        return -1;
     }
 
-    if (!self->dot_flashing_enabled[self->current_digit]) {
-        segments &= ~SEGMENT_P; /**< Apagar punto decimal si no está habilitado */
+    self->scroll_length = 0; /**< Detener la marquesina anterior mientras se arma la nueva */
+    for (length = 0; (length < SCREEN_SCROLL_MAX) && (text[length] != '\0'); length++) {
+        self->scroll[length] = ScreenGlyph(text[length]);
+    }
+    if (length <= self->digits) {
+        return ScreenWriteText(self, text); /**< Entra completo, desplazarlo lo mostraría repetido en la pantalla */
     }
+    self->scroll[length++] = 0; /**< Espacio que separa el final del texto de su repetición */
 
-    self->driver->SegmentsUpdate(segments);         /**< Actualizar segmentos del dígito actual */
-    self->driver->DigitTurnOn(self->current_digit); /**< Encender el dígito actual */
+    self->scroll_offset = 0;
+    self->scroll_count = 0;
+    self->scroll_divisor = divisor;
+    self->scroll_length = length;
+    return 0;
+}
+
+__ramfunc void ScreenRefresh(screen_t self) {
+    for (screen_t panel = self; panel != NULL; panel = panel->next) {
+        ScreenRefreshPanel(panel); /**< Todas las pantallas encadenadas avanzan un dígito en el mismo intervalo */
+    }
 }
 
 int DisplayFlashDigits(screen_t self, uint8_t from, uint8_t to, uint16_t divisor) {
     int result = 0;
-    if ((from > to) || (from >= SCREEN_MAX_DIGITS) || (to >= SCREEN_MAX_DIGITS)) {
+    if (!self) {
         result = -1;
-    } else if (!self) {
+    } else if ((from > to) || (from >= self->digits) || (to >= self->digits)) {
         result = -1;
     } else {
-        self->flashing_from = from;
-        self->flashing_to = to;
-        self->flashing_frequency_display = 2 * divisor;
+        for (uint8_t i = 0; i < self->digits; i++) {
+            if ((divisor != 0) && (i >= from) && (i <= to)) {
+                self->digit[i].flags |= DIGIT_FLASH;
+            } else {
+                self->digit[i].flags &= ~DIGIT_FLASH;
+            }
+        }
+        if (divisor != 0) {
+            self->flash_period = 2 * divisor;
+        }
     }
 
     return result;
@@ -171,31 +374,87 @@ int DisplayFlashDigits(screen_t self, uint8_t from, uint8_t to, uint16_t divisor
 
 int DisplayFlashDot(screen_t self, uint8_t digit, uint16_t divisor, bool flashing_enabled) {
     int result = 0;
-    if ((!self) || (digit >= SCREEN_MAX_DIGITS)) {
+    if ((!self) || (digit >= self->digits)) {
         result = -1;
     } else {
-        self->flashing_frequency_dot[digit] = 2 * divisor;
+        self->digit[digit].flags &= ~(DOT_ON | DOT_FLASH);
+        if (flashing_enabled) {
+            self->digit[digit].flags |= DOT_ON; /**< Habilitar el punto decimal */
+            if (divisor != 0) {
+                self->digit[digit].flags |= DOT_FLASH; /**< Parpadea en fase con el resto de la pantalla */
+                self->flash_period = 2 * divisor;
+            }
+        }
     }
 
-    if (flashing_enabled) {
-        self->dot_flashing_enabled[digit] = true; /**< Habilitar parpadeo del punto decimal */
+    return result;
+}
+
+int DotTurningOn(screen_t self, uint8_t digit, bool turning_on) {
+    int result = 0;
+    if ((!self) || (digit >= self->digits)) {
+        result = -1;
     } else {
-        self->dot_flashing_enabled[digit] = false; /**< Deshabilitar parpadeo del punto decimal */
+        if (turning_on) {
+            self->digit[digit].flags |= DOT_ON; /**< Encender el punto decimal */
+        } else {
+            self->digit[digit].flags &= ~DOT_ON; /**< Apagar el punto decimal */
+        }
     }
 
     return result;
 }
 
-int DotTurningOn(screen_t self, uint8_t digit, bool turning_on) {
+int ScreenSetBrightness(screen_t self, uint8_t level) {
+    int result = 0;
+    if ((!self) || (level > SCREEN_BRIGHTNESS_MAX) || (self->driver->DigitDim == NULL)) {
+        result = -1;
+    } else {
+        self->brightness = level;
+        self->brightness_target = level; /**< Cancelar cualquier transición en curso */
+    }
+
+    return result;
+}
+
+int ScreenFadeBrightness(screen_t self, uint8_t level, uint16_t divisor) {
     int result = 0;
-    if ((!self) || (digit >= SCREEN_MAX_DIGITS)) {
+    if ((!self) || (level > SCREEN_BRIGHTNESS_MAX) || (self->driver->DigitDim == NULL)) {
         result = -1;
     } else {
-        self->dot_turning_on[digit] = turning_on; /**< Actualizar estado del punto decimal */
+        self->fade_count = 0;
+        self->fade_divisor = divisor;
+        self->brightness_target = level;
     }
 
     return result;
 }
 
+int ScreenFlashMask(screen_t self, uint32_t digits, uint32_t dots, uint16_t divisor) {
+    int result = 0;
+    if ((!self) || (divisor == 0)) {
+        result = -1;
+    } else {
+        for (uint8_t i = 0; i < self->digits; i++) {
+            uint32_t bit = (i < 32) ? (1UL << i) : 0;
+
+            self->digit[i].flags &= ~(DIGIT_FLASH | DOT_FLASH);
+            if (digits & bit) {
+                self->digit[i].flags |= DIGIT_FLASH;
+            }
+            if (dots & bit) {
+                self->digit[i].flags |= DOT_FLASH;
+            }
+        }
+        self->flash_period = 2 * divisor;
+    }
+
+    return result;
+}
+
+uint8_t ScreenGetBrightness(screen_t self) {
+    return self->brightness;
+}
+
 /* === End of documentation ========================================================================================
  */
@@ -0,0 +1,175 @@
+/*********************************************************************************************************************
+Copyright (c) 2025, Martín Fernando Gareca del autor <mfgareca36@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*********************************************************************************************************************/
+
+/** @file settings.c
+ ** @brief Implementación del almacenamiento persistente de la configuración en un registro circular
+ **/
+
+/* === Headers files inclusions ==================================================================================== */
+
+#include "settings.h"
+#include <stddef.h>
+#include <string.h>
+
+/* === Macros definitions ========================================================================================== */
+
+#define SETTINGS_CRC_POLY 0xEDB88320 // Polinomio CRC-32 reflejado
+
+//! Bytes que ocupa un registro en la memoria, sin el relleno final de la estructura, que el CRC no protege
+#define SETTINGS_RECORD_SIZE (offsetof(struct settings_record_s, data) + sizeof(settings_t))
+
+/* === Private data type declarations ============================================================================== */
+
+//! Registro guardado en cada posición de la memoria, el encabezado no cambia de una versión a otra
+struct settings_record_s {
+    uint32_t sequence; /**< Número de orden, el mayor es el más reciente */
+    uint16_t version;  /**< Versión del formato de la configuración guardada */
+    uint16_t size;     /**< Bytes de configuración guardados, el tamaño de settings_t en esa versión */
+    uint32_t crc;      /**< CRC-32 del resto del encabezado y de los bytes de configuración guardados */
+    settings_t data;   /**< Configuración guardada */
+};
+
+//! Estado del almacenamiento
+struct settings_store_s {
+    settings_storage_t storage;      /**< Memoria donde se guardan los registros */
+    uint32_t slots;                  /**< Cantidad de posiciones de la memoria */
+    uint32_t next;                   /**< Posición donde se escribirá el próximo registro */
+    bool valid;                      /**< Indica si last contiene un registro válido */
+    struct settings_record_s last;   /**< Último registro válido */
+};
+
+/* === Private function declarations =============================================================================== */
+
+static uint32_t Crc(uint32_t crc, const void * data, uint32_t size);
+
+static uint32_t RecordCrc(const struct settings_record_s * record);
+
+static bool RecordRead(uint32_t slot, struct settings_record_s * record);
+
+/* === Private variable definitions ================================================================================ */
+
+//! El registro debe entrar en una posición para no cruzar el límite de una página
+typedef char settings_record_fits_t[(sizeof(struct settings_record_s) <= SETTINGS_SLOT_SIZE) ? 1 : -1];
+
+static struct settings_store_s self[1];
+
+/* === Public variable definitions ================================================================================= */
+
+/* === Private function definitions ================================================================================ */
+
+static uint32_t Crc(uint32_t crc, const void * data, uint32_t size) {
+    const uint8_t * bytes = data;
+    uint32_t index;
+    uint8_t bit;
+
+    for (index = 0; index < size; index++) {
+        crc ^= bytes[index];
+        for (bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ ((crc & 1) ? SETTINGS_CRC_POLY : 0);
+        }
+    }
+    return crc;
+}
+
+static uint32_t RecordCrc(const struct settings_record_s * record) {
+    uint32_t crc = Crc(0xFFFFFFFF, record, offsetof(struct settings_record_s, crc));
+    return ~Crc(crc, &record->data, record->size);
+}
+
+static bool RecordRead(uint32_t slot, struct settings_record_s * record) {
+    self->storage->Read(slot * SETTINGS_SLOT_SIZE, record, sizeof(*record));
+    if ((record->version > SETTINGS_VERSION) || (record->size > sizeof(settings_t)) ||
+        (record->crc != RecordCrc(record))) {
+        return false; /**< Registro incompleto, de otro formato o de una versión posterior */
+    }
+
+    // Los campos que no existían en la versión del registro toman su valor por omisión
+    memset((uint8_t *)&record->data + record->size, 0, sizeof(settings_t) - record->size);
+    return true;
+}
+
+/* === Public function definitions ================================================================================= */
+
+bool SettingsInit(settings_storage_t storage) {
+    struct settings_record_s record;
+    uint32_t slot;
+
+    memset(self, 0, sizeof(self));
+    if ((storage == NULL) || (storage->Read == NULL) || (storage->Write == NULL) ||
+        (storage->size < SETTINGS_SLOT_SIZE)) {
+        return false;
+    }
+    self->storage = storage;
+    self->slots = storage->size / SETTINGS_SLOT_SIZE;
+
+    // Un solo recorrido acotado: el registro más reciente es el de mayor número de orden con CRC correcto
+    for (slot = 0; slot < self->slots; slot++) {
+        if (RecordRead(slot, &record) && (!self->valid || ((int32_t)(record.sequence - self->last.sequence) > 0))) {
+            self->last = record;
+            self->valid = true;
+            self->next = (slot + 1) % self->slots;
+        }
+    }
+
+    return self->valid;
+}
+
+bool SettingsLoad(settings_t * settings) {
+    if (self->valid) {
+        memcpy(settings, &self->last.data, sizeof(settings_t));
+    }
+    return self->valid;
+}
+
+int SettingsSave(const settings_t * settings) {
+    struct settings_record_s record;
+    uint32_t attempt;
+
+    if (self->storage == NULL) {
+        return -1;
+    }
+    if (self->valid && (memcmp(&self->last.data, settings, sizeof(settings_t)) == 0)) {
+        return 0; /**< Sin cambios, se evita desgastar la memoria */
+    }
+
+    memset(&record, 0, sizeof(record));
+    record.sequence = self->valid ? self->last.sequence + 1 : 0;
+    record.version = SETTINGS_VERSION;
+    record.size = sizeof(settings_t);
+    memcpy(&record.data, settings, sizeof(settings_t));
+    record.crc = RecordCrc(&record);
+
+    // Si una posición falla al verificarla se prueba con la siguiente, el registro anterior sigue siendo válido
+    for (attempt = 0; attempt < 2; attempt++) {
+        uint32_t slot = self->next;
+
+        self->next = (self->next + 1) % self->slots;
+        if (self->storage->Write(slot * SETTINGS_SLOT_SIZE, &record, SETTINGS_RECORD_SIZE)) {
+            struct settings_record_s check;
+            if (RecordRead(slot, &check) && (memcmp(&check, &record, SETTINGS_RECORD_SIZE) == 0)) {
+                self->last = record;
+                self->valid = true;
+                return 0;
+            }
+        }
+    }
+    return -1;
+}
+
+/* === End of documentation ======================================================================================== */
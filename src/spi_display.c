@@ -0,0 +1,106 @@
+/*********************************************************************************************************************
+Copyright (c) 2025, Martín Fernando Gareca del autor <mfgareca36@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*********************************************************************************************************************/
+
+/** @file spi_display.c
+ ** @brief Implementación del driver de pantalla con registros de desplazamiento en serie
+ **/
+
+/* === Headers files inclusions ==================================================================================== */
+
+#include "spi_display.h"
+#include "ramfunc.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+/* === Macros definitions ========================================================================================== */
+
+/* === Private data type declarations ============================================================================== */
+
+//! Estado del driver, los callbacks de pantalla no reciben contexto por lo que hay una única instancia
+struct spi_display_s {
+    uint8_t digits;                        /**< Cantidad de registros de la cadena */
+    uint8_t segments;                      /**< Segmentos recibidos para el próximo dígito que se encienda */
+    bool changed;                          /**< Indica si la trama cambió desde el último envío */
+    spi_display_send_t send;               /**< Función que envía la trama a la cadena */
+    uint8_t frame[SPI_DISPLAY_MAX_DIGITS]; /**< Trama en el orden en que se desplaza */
+};
+
+/* === Private function declarations =============================================================================== */
+
+static void SpiDigitsTurnOff(void);
+
+static void SpiSegmentsUpdate(uint8_t value);
+
+static void SpiDigitTurnOn(uint8_t digit);
+
+/* === Private variable definitions ================================================================================ */
+
+static struct spi_display_s self[1];
+
+static const struct screen_driver_s spi_driver = {
+    .DigitsTurnOff = SpiDigitsTurnOff,   // Los registros mantienen su valor, no hay nada que apagar
+    .SegmentsUpdate = SpiSegmentsUpdate, // Guarda los segmentos del próximo dígito
+    .DigitTurnOn = SpiDigitTurnOn,       // Actualiza la trama y la envía al completar el barrido
+    .DigitDim = NULL                     // El brillo de los registros no es controlable por software
+};
+
+/* === Public variable definitions ================================================================================= */
+
+/* === Private function definitions ================================================================================ */
+
+static void SpiDigitsTurnOff(void) {
+}
+
+__ramfunc static void SpiSegmentsUpdate(uint8_t value) {
+    self->segments = value;
+}
+
+__ramfunc static void SpiDigitTurnOn(uint8_t digit) {
+    uint8_t position;
+
+    if (digit < self->digits) {
+        position = self->digits - 1 - digit; /**< El primer byte desplazado termina en el último registro */
+        if (self->frame[position] != self->segments) {
+            self->frame[position] = self->segments;
+            self->changed = true;
+        }
+        if ((digit == self->digits - 1) && self->changed) {
+            self->changed = false;
+            self->send(self->frame, self->digits); /**< Una sola transferencia por barrido completo */
+        }
+    }
+}
+
+/* === Public function definitions ================================================================================= */
+
+screen_driver_t SpiDisplayCreate(uint8_t digits, spi_display_send_t send) {
+    if ((digits == 0) || (digits > SPI_DISPLAY_MAX_DIGITS) || (send == NULL)) {
+        return NULL;
+    }
+
+    memset(self, 0, sizeof(self));
+    self->digits = digits;
+    self->send = send;
+    self->send(self->frame, self->digits); /**< Apagar todos los registros */
+
+    return &spi_driver;
+}
+
+/* === End of documentation ======================================================================================== */
@@ -0,0 +1,463 @@
+/*********************************************************************************************************************
+Copyright (c) 2025, Martín Fernando Gareca del autor <mfgareca36@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*********************************************************************************************************************/
+
+
+/** @file sync.c
+ ** @brief Implementación de la sincronización de la hora con una referencia externa por serie y pulso por segundo
+ **/
+
+/* === Headers files inclusions ==================================================================================== */
+
+#include "sync.h"
+#include "bcd.h"
+#include "monitor.h"
+#include "task.h"
+#include <stddef.h>
+
+/* === Macros definitions ========================================================================================== */
+
+#if (SYNC_RX_SIZE & (SYNC_RX_SIZE - 1)) != 0
+#error "SYNC_RX_SIZE debe ser una potencia de dos"
+#endif
+
+#define RX_MASK (SYNC_RX_SIZE - 1)
+
+#define NMEA_LENGTH_MAX 82 /**< Longitud máxima de una sentencia NMEA, del $ al fin de línea */
+
+#define COUNTS_PER_MS (MONITOR_TIMER_HZ / 1000)
+
+#define SECONDS_PER_DAY 86400
+
+/* === Private data type declarations ============================================================================== */
+
+//! Estado del intérprete de mensajes
+typedef enum {
+    SYNC_IDLE,          /**< Esperando el comienzo de un mensaje */
+    SYNC_NMEA,          /**< Dentro de una sentencia NMEA, antes del asterisco */
+    SYNC_NMEA_CHECKSUM, /**< Leyendo los dos dígitos hexadecimales de la suma de verificación */
+    SYNC_FRAME_HEADER,  /**< Recibido el primer byte de una trama binaria */
+    SYNC_FRAME,         /**< Dentro de una trama binaria */
+} sync_state_t;
+
+//! Campos de la sentencia NMEA en curso que interesan, se completan a medida que llegan los caracteres
+typedef struct sync_nmea_s {
+    uint8_t length;          /**< Caracteres recibidos desde el $ */
+    uint8_t field;           /**< Número del campo en curso, 0 para el identificador */
+    uint8_t position;        /**< Posición dentro del campo en curso */
+    uint8_t checksum;        /**< O exclusivo de los caracteres entre el $ y el asterisco */
+    uint8_t received;        /**< Suma de verificación recibida */
+    uint8_t digits;          /**< Dígitos recibidos de la suma de verificación */
+    bool rmc;                /**< El identificador de la sentencia es RMC */
+    bool valid;              /**< Los campos de hora y fecha tienen el formato esperado */
+    char status;             /**< Estado del receptor, A con posición válida */
+    uint8_t time[6];         /**< Dígitos hhmmss de la hora */
+    uint8_t time_digits;     /**< Dígitos recibidos de la hora */
+    uint16_t fraction;       /**< Fracción de segundo, con fraction_digits dígitos */
+    uint8_t fraction_digits; /**< Dígitos recibidos de la fracción, se usan los tres primeros */
+    uint8_t date[6];         /**< Dígitos ddmmyy de la fecha */
+    uint8_t date_digits;     /**< Dígitos recibidos de la fecha */
+} sync_nmea_t;
+
+//! Estado de la sincronización
+struct sync_s {
+    sync_port_t port;               /**< Puerto serie de la referencia */
+    clock_t clock;                  /**< Reloj que se sincroniza */
+    volatile int16_t utc_offset;    /**< Minutos que se suman a la hora UTC para obtener la local */
+    uint16_t rx_tail;               /**< Posición del próximo byte recibido sin procesar */
+    sync_state_t state;             /**< Estado del intérprete */
+    sync_nmea_t nmea;               /**< Sentencia NMEA en curso */
+    uint8_t frame[SYNC_FRAME_SIZE]; /**< Trama binaria en curso */
+    uint8_t frame_length;           /**< Bytes recibidos de la trama binaria */
+    volatile uint32_t pulses;       /**< Pulsos registrados por la interrupción */
+    volatile uint32_t pulse_count;  /**< Contador del monitor en el último pulso */
+    uint32_t pulses_applied;        /**< Pulsos ya aplicados al reloj */
+    sync_stats_t stats;             /**< Estadísticas */
+};
+
+/* === Private function declarations =============================================================================== */
+
+static bool LastPulse(uint16_t * age_ms);
+
+static void Apply(const clock_time_t * time, const clock_date_t * date, uint16_t fraction_ms);
+
+static void ToLocal(clock_time_t * time, clock_date_t * date);
+
+static void NmeaStart(void);
+
+static void NmeaField(char character);
+
+static void NmeaEnd(void);
+
+static void FrameEnd(void);
+
+static void Feed(uint8_t character);
+
+/* === Private variable definitions ================================================================================ */
+
+static struct sync_s self[1];
+
+/* === Public variable definitions ================================================================================= */
+
+/* === Private function definitions ================================================================================ */
+
+static bool LastPulse(uint16_t * age_ms) {
+    uint32_t pulses;
+    uint32_t count;
+    uint32_t age;
+
+    // La interrupción puede registrar otro pulso entre las dos lecturas, se repiten hasta que coincidan
+    do {
+        pulses = self->pulses;
+        count = self->pulse_count;
+    } while (pulses != self->pulses);
+
+    if (pulses == 0) {
+        return false;
+    }
+    age = (MonitorTimerGetCount() - count + COUNTS_PER_MS / 2) / COUNTS_PER_MS;
+    if (age >= 1000) {
+        return false; /**< Sin pulso en el último segundo, el receptor perdió la referencia o no tiene salida */
+    }
+    *age_ms = age;
+    return true;
+}
+
+static void Apply(const clock_time_t * time, const clock_date_t * date, uint16_t fraction_ms) {
+    clock_time_t before;
+    uint16_t elapsed = fraction_ms;
+    bool locked = false;
+    bool valid;
+    int32_t offset;
+    bool result;
+
+    // Un mensaje de segundos enteros nombra el segundo que comenzó en el último pulso, la edad del pulso se mide con
+    // el reloj detenido para que una interrupción o un cambio de tarea no se sumen a la corrección
+    taskENTER_CRITICAL();
+    if ((fraction_ms == 0) && LastPulse(&elapsed)) {
+        locked = true;
+    }
+    valid = ClockGetTime(self->clock, &before);
+    offset = (int32_t)(BcdTimeToSeconds(time) * 1000 + elapsed) -
+             (int32_t)(BcdTimeToSeconds(&before) * 1000 + ClockGetMilliseconds(self->clock));
+    result = ClockSync(self->clock, time, date, elapsed);
+    taskEXIT_CRITICAL();
+
+    if (!result) {
+        self->stats.rejected++;
+        return;
+    }
+
+    // La diferencia más corta dentro del día, el reloj puede estar a cada lado de la medianoche
+    if (offset > SECONDS_PER_DAY * 1000 / 2) {
+        offset -= SECONDS_PER_DAY * 1000;
+    } else if (offset < -SECONDS_PER_DAY * 1000 / 2) {
+        offset += SECONDS_PER_DAY * 1000;
+    }
+    self->stats.messages++;
+    self->stats.offset_ms = valid ? offset : 0;
+    self->stats.pulse_locked = locked;
+}
+
+static void ToLocal(clock_time_t * time, clock_date_t * date) {
+    int16_t offset = self->utc_offset;
+    uint8_t days = ClockDaysInMonth(date->year, date->month);
+    int32_t seconds;
+
+    if ((offset == 0) || !BcdTimeIsValid(time) || (date->day == 0) || (date->day > days)) {
+        return; /**< Los valores inválidos no se corrigen, así ClockSync los rechaza */
+    }
+
+    // La diferencia son minutos enteros, los segundos y la fase del pulso no cambian
+    seconds = (int32_t)BcdTimeToSeconds(time) + offset * 60;
+    if (seconds < 0) {
+        seconds += SECONDS_PER_DAY;
+        if (--date->day == 0) {
+            if (--date->month == 0) {
+                date->month = 12;
+                date->year--;
+            }
+            date->day = ClockDaysInMonth(date->year, date->month);
+        }
+    } else if (seconds >= SECONDS_PER_DAY) {
+        seconds -= SECONDS_PER_DAY;
+        if (++date->day > days) {
+            date->day = 1;
+            if (++date->month > 12) {
+                date->month = 1;
+                date->year++;
+            }
+        }
+    }
+    BcdTimeFromSeconds(time, seconds);
+}
+
+static void NmeaStart(void) {
+    self->state = SYNC_NMEA;
+    self->nmea = (sync_nmea_t){.rmc = true, .valid = true};
+}
+
+static void NmeaField(char character) {
+    sync_nmea_t * nmea = &self->nmea;
+    bool digit = (character >= '0') && (character <= '9');
+
+    if (character == ',') {
+        nmea->field++;
+        nmea->position = 0;
+        return;
+    }
+
+    switch (nmea->field) {
+    case 0: /**< Identificador: dos letras del sistema seguidas de RMC */
+        if ((nmea->position >= 5) || ((nmea->position >= 2) && (character != "RMC"[nmea->position - 2]))) {
+            nmea->rmc = false;
+        }
+        break;
+    case 1: /**< Hora hhmmss, con una fracción opcional */
+        if (nmea->position < 6) {
+            if (digit) {
+                nmea->time[nmea->time_digits++] = character - '0';
+            } else {
+                nmea->valid = false;
+            }
+        } else if (nmea->position == 6) {
+            nmea->valid = nmea->valid && (character == '.');
+        } else if (!digit) {
+            nmea->valid = false;
+        } else if (nmea->fraction_digits < 3) {
+            nmea->fraction = nmea->fraction * 10 + (character - '0');
+            nmea->fraction_digits++;
+        }
+        break;
+    case 2: /**< Estado */
+        nmea->status = character;
+        break;
+    case 9: /**< Fecha ddmmyy */
+        if ((nmea->position < 6) && digit) {
+            nmea->date[nmea->date_digits++] = character - '0';
+        } else {
+            nmea->valid = false;
+        }
+        break;
+    default:
+        break;
+    }
+    nmea->position++;
+}
+
+static void NmeaEnd(void) {
+    static const uint16_t SCALE[] = {0, 100, 10, 1};
+    sync_nmea_t * nmea = &self->nmea;
+    clock_time_t time;
+    clock_date_t date;
+    uint8_t year;
+
+    if (!nmea->rmc) {
+        return; /**< Otras sentencias del receptor */
+    }
+    if ((nmea->received != nmea->checksum) || !nmea->valid || (nmea->time_digits != 6) || (nmea->date_digits != 6)) {
+        self->stats.rejected++;
+        return;
+    }
+    if (nmea->status != 'A') {
+        return; /**< El receptor todavía no tiene una referencia válida */
+    }
+
+    time.time.hours[1] = nmea->time[0];
+    time.time.hours[0] = nmea->time[1];
+    time.time.minutes[1] = nmea->time[2];
+    time.time.minutes[0] = nmea->time[3];
+    time.time.seconds[1] = nmea->time[4];
+    time.time.seconds[0] = nmea->time[5];
+
+    // El año llega con dos dígitos, los receptores anteriores a 1980 no existen
+    year = nmea->date[4] * 10 + nmea->date[5];
+    date.year = (year < 80) ? 2000 + year : 1900 + year;
+    date.month = nmea->date[2] * 10 + nmea->date[3];
+    date.day = nmea->date[0] * 10 + nmea->date[1];
+    date.weekday = 0;
+
+    ToLocal(&time, &date);
+    Apply(&time, &date, nmea->fraction * SCALE[nmea->fraction_digits]);
+}
+
+static void FrameEnd(void) {
+    const uint8_t * frame = self->frame;
+    clock_time_t time;
+    clock_date_t date;
+    uint16_t milliseconds;
+    uint8_t checksum = 0;
+    uint8_t index;
+
+    for (index = 0; index < SYNC_FRAME_SIZE - 1; index++) {
+        checksum ^= frame[index];
+    }
+    milliseconds = frame[7] | (frame[8] << 8);
+    if ((checksum != frame[SYNC_FRAME_SIZE - 1]) || (frame[4] > 99) || (frame[5] > 99) || (frame[6] > 99) ||
+        (milliseconds >= 1000)) {
+        self->stats.rejected++;
+        return;
+    }
+
+    date.year = frame[0] | (frame[1] << 8);
+    date.month = frame[2];
+    date.day = frame[3];
+    date.weekday = 0;
+    time.time.hours[1] = frame[4] / 10;
+    time.time.hours[0] = frame[4] % 10;
+    time.time.minutes[1] = frame[5] / 10;
+    time.time.minutes[0] = frame[5] % 10;
+    time.time.seconds[1] = frame[6] / 10;
+    time.time.seconds[0] = frame[6] % 10;
+
+    Apply(&time, &date, milliseconds);
+}
+
+static void Feed(uint8_t character) {
+    uint8_t value;
+
+    switch (self->state) {
+    case SYNC_FRAME: /**< Los datos de la trama pueden tomar cualquier valor, incluso los de comienzo */
+        self->frame[self->frame_length++] = character;
+        if (self->frame_length == SYNC_FRAME_SIZE) {
+            FrameEnd();
+            self->state = SYNC_IDLE;
+        }
+        break;
+    case SYNC_FRAME_HEADER:
+        if (character == SYNC_FRAME_SYNC) {
+            self->frame_length = 0;
+            self->state = SYNC_FRAME;
+        } else if (character == '$') {
+            NmeaStart();
+        } else {
+            self->state = SYNC_IDLE;
+        }
+        break;
+    case SYNC_NMEA:
+        if (character == '$') {
+            NmeaStart(); /**< Sentencia cortada, comienza otra */
+        } else if (character == '*') {
+            self->state = SYNC_NMEA_CHECKSUM;
+        } else if ((character < ' ') || (++self->nmea.length > NMEA_LENGTH_MAX)) {
+            self->stats.rejected += self->nmea.rmc ? 1 : 0;
+            self->state = SYNC_IDLE;
+        } else {
+            self->nmea.checksum ^= character;
+            NmeaField(character);
+        }
+        break;
+    case SYNC_NMEA_CHECKSUM:
+        if ((character >= '0') && (character <= '9')) {
+            value = character - '0';
+        } else if ((character >= 'A') && (character <= 'F')) {
+            value = character - 'A' + 10;
+        } else {
+            self->stats.rejected += self->nmea.rmc ? 1 : 0;
+            if (character == '$') {
+                NmeaStart();
+            } else {
+                self->state = SYNC_IDLE;
+            }
+            break;
+        }
+        self->nmea.received = (self->nmea.received << 4) | value;
+        if (++self->nmea.digits == 2) {
+            NmeaEnd();
+            self->state = SYNC_IDLE;
+        }
+        break;
+    default:
+        if (character == '$') {
+            NmeaStart();
+        } else if (character == SYNC_FRAME_START) {
+            self->state = SYNC_FRAME_HEADER;
+        }
+        break;
+    }
+}
+
+/* === Public function definitions ================================================================================= */
+
+void SyncInit(sync_port_t port, clock_t clock) {
+    self->port = port;
+    self->clock = clock;
+    self->rx_tail = (port != NULL) ? port->RxPosition() & RX_MASK : 0; /**< Lo recibido antes es una hora vieja */
+    self->state = SYNC_IDLE;
+    self->pulses_applied = self->pulses;
+    self->stats = (sync_stats_t){0};
+}
+
+void SyncPulse(void) {
+    self->pulse_count = MonitorTimerGetCount();
+    self->pulses++;
+}
+
+void SyncPoll(void) {
+    uint16_t head;
+    uint16_t age;
+    uint32_t pulses = self->pulses;
+
+    // Primero la fase, así el mensaje del mismo segundo se aplica sobre el reloj ya alineado
+    if (pulses != self->pulses_applied) {
+        taskENTER_CRITICAL();
+        if (LastPulse(&age)) {
+            self->stats.offset_ms = ClockAlignSecond(self->clock, age);
+        }
+        taskEXIT_CRITICAL();
+    }
+    self->pulses_applied = pulses;
+    self->stats.pulses = self->pulses_applied;
+
+    if (self->port == NULL) {
+        return;
+    }
+    head = self->port->RxPosition() & RX_MASK;
+    while (self->rx_tail != head) {
+        Feed(self->port->rx_buffer[self->rx_tail]);
+        self->rx_tail = (self->rx_tail + 1) & RX_MASK;
+    }
+}
+
+bool SyncSetUtcOffset(int16_t minutes) {
+    if ((minutes < SYNC_UTC_OFFSET_MIN) || (minutes > SYNC_UTC_OFFSET_MAX)) {
+        return false;
+    }
+    self->utc_offset = minutes;
+    return true;
+}
+
+int16_t SyncGetUtcOffset(void) {
+    return self->utc_offset;
+}
+
+void SyncGetStats(sync_stats_t * stats) {
+    *stats = self->stats;
+}
+
+void SyncTask(void * pointer) {
+    sync_task_args_t args = pointer;
+
+    SyncInit(args->port, args->clock);
+    while (1) {
+        vTaskDelay(pdMS_TO_TICKS(SYNC_PERIOD_MS));
+        SyncPoll();
+    }
+}
+
+/* === End of documentation ======================================================================================== */
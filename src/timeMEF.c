@@ -24,47 +24,299 @@ SPDX-License-Identifier: MIT
 /* === Headers files inclusions ==================================================================================== */
 
 #include "timeMEF.h"
+#include "buzzer.h"
+#include "power.h"
+#include "settings.h"
+#include "sync.h"
+#include "trace.h"
+#include "timers.h"
 #include <stdbool.h>
+#include <string.h>
 
 /* === Macros definitions ========================================================================================== */
 
-/* === Private data type declarations ============================================================================== */
-
-/* === Private function declarations =============================================================================== */
+#define LAP_SHOW_MS          2000 // Tiempo que queda congelada en la pantalla una vuelta del cronómetro
+#define COUNTDOWN_MINUTES    5    // Duración inicial de la cuenta regresiva
+#define COUNTDOWN_MAX_MINUTE 99   // Duración máxima de la cuenta regresiva que se puede elegir
+#define COUNTDOWN_VOLUME     8    // Volumen del aviso de fin de la cuenta regresiva
+#define ADJUST_TIMEOUT_MS    30000 // Tiempo sin teclas que cancela un ajuste
+#define CLOCK_PERIOD_MS      100   // Período de actualización de la hora, la alarma se verifica en cada segundo
+#define CHRONO_PERIOD_MS     10    // Período de actualización del cronómetro y la cuenta regresiva
+#define SCREEN_SWEEP_MS      4     // Barrido completo de la pantalla, un dígito por milisegundo
+#define MESSAGE_FRAME_MS     300   // Tiempo que dura cada cuadro de un mensaje desplazándose por la pantalla
 
-/* === Private variable definitions ================================================================================ */
+/* === Private data type declarations ============================================================================== */
 
+//! Estados de la MEF, tools/trace_decode.py repite este orden para nombrarlos
 typedef enum {
     STATE_SHOW_TIME,
     STATE_ADJUST_TIME_MINUTES,
     STATE_ADJUST_TIME_HOURS,
+    STATE_ADJUST_DATE_DAY,
+    STATE_ADJUST_DATE_MONTH,
+    STATE_ADJUST_DATE_YEAR,
     STATE_ADJUST_ALARM_MINUTES,
     STATE_ADJUST_ALARM_HOURS,
-    STATE_CONTROL_ALARM
+    STATE_ADJUST_ALARM_DAYS,
+    STATE_CONTROL_ALARM,
+    STATE_STOPWATCH,
+    STATE_COUNTDOWN
 } clock_state_t;
 
+/* === Private function declarations =============================================================================== */
+
+static void SaveSettings(time_task_args_t args, bool alarm_enabled);
+
+static void ShowDate(time_task_args_t args, const clock_date_t * date, bool year);
+
+static void ShowAlarmDays(time_task_args_t args, uint8_t option);
+
+static void ShowMessage(time_task_args_t args, const char * text, uint8_t length);
+
+static void ShowDateMessage(time_task_args_t args);
+
+static void ShowAlarmMessage(time_task_args_t args);
+
+static void ChangeDate(clock_date_t * date, clock_state_t field, bool increment);
+
+static void ShowChrono(time_task_args_t args, uint32_t milliseconds);
+
+static void CountdownExpired(void * context);
+
+static void AdjustTimeout(TimerHandle_t timer);
+
+static TickType_t StateWait(clock_state_t state);
+
+/* === Private variable definitions ================================================================================ */
+
+//! Opciones de días de alarma que se recorren con incrementar y decrementar
+static const struct {
+    uint8_t days;      /**< Máscara de días de la semana */
+    const char * text; /**< Texto mostrado en la pantalla */
+} ALARM_DAYS[] = {
+    {CLOCK_EVERY_DAY, "todo"}, /**< Todos los días */
+    {CLOCK_WORKDAYS, "LAb"},   /**< Días laborables, de lunes a viernes */
+    {CLOCK_WEEKEND, "FdS"},    /**< Fin de semana */
+};
+
+#define ALARM_DAYS_OPTIONS (sizeof(ALARM_DAYS) / sizeof(ALARM_DAYS[0]))
+
+static const buzzer_note_t COUNTDOWN_NOTES[] = {{2500, 150}, {0, 100}, {2500, 150}, {0, 100}, {2500, 150}, {0, 600}};
+
+//! Aviso de fin de la cuenta regresiva, tres pitidos que se tocan una sola vez
+static const buzzer_melody_t COUNTDOWN_MELODY = {COUNTDOWN_NOTES, sizeof(COUNTDOWN_NOTES) / sizeof(COUNTDOWN_NOTES[0])};
+
 /* === Public variable definitions ================================================================================= */
 
 bool adjusting_time = false;
 
 uint32_t set_time_pressed_ticks = 0;
-uint32_t last_activity_ticks_time = 0;
 clock_time_t time_backup;
 clock_time_t editable_time;
 clock_time_t editable_alarm;
 
 bool adjusting_alarm = false;
 uint32_t set_alarm_pressed_ticks = 0;
-uint32_t last_activity_ticks_alarm = 0;
 
 volatile uint32_t ticks = 0;
 
 static clock_state_t current_state = STATE_SHOW_TIME;
 
+static bool alarm_configured = false;
+
+//! Otra tarea cambió la configuración, se guarda en la próxima pasada por la hora sin esperar el cambio de minuto
+static volatile bool settings_pending = false;
+
+static clock_date_t editable_date;
+
+static uint8_t editable_alarm_days = 0;
+
+static uint8_t countdown_minutes = COUNTDOWN_MINUTES;
+
+static bool alarm_sounding = false;
+
+static TimerHandle_t adjust_timer = NULL;
+
+static bool message_active = false;
+
+static TickType_t message_start;
+
+static TickType_t message_ticks;
+
 /* === Private function definitions ================================================================================ */
 
+static void SaveSettings(time_task_args_t args, bool alarm_enabled) {
+    settings_t settings;
+
+    memset(&settings, 0, sizeof(settings)); // Sin basura en el relleno, que también se compara y se guarda
+    settings.time_valid = ClockGetTime(args->clock, &settings.time);
+    ClockGetAlarm(args->clock, &settings.alarm);
+    settings.alarm_valid = alarm_configured;
+    settings.alarm_enabled = alarm_enabled;
+    settings.brightness = ScreenGetBrightness(args->board->screen);
+    settings.date_valid = ClockGetDate(args->clock, &settings.date);
+    settings.alarm_days = ClockGetAlarmDays(args->clock);
+    settings.utc_offset = SyncGetUtcOffset();
+    SettingsSave(&settings);
+}
+
+static void ShowDate(time_task_args_t args, const clock_date_t * date, bool year) {
+    uint8_t digits[4];
+
+    if (year) {
+        digits[0] = date->year % 10;
+        digits[1] = (date->year / 10) % 10;
+        digits[2] = (date->year / 100) % 10;
+        digits[3] = date->year / 1000;
+    } else {
+        digits[0] = date->month % 10; // Día y mes en el lugar de las horas y los minutos
+        digits[1] = date->month / 10;
+        digits[2] = date->day % 10;
+        digits[3] = date->day / 10;
+    }
+    ScreenWriteBCD(args->board->screen, digits, 4);
+}
+
+static void ShowAlarmDays(time_task_args_t args, uint8_t option) {
+    ScreenWriteText(args->board->screen, ALARM_DAYS[option].text);
+}
+
+static void ShowMessage(time_task_args_t args, const char * text, uint8_t length) {
+    DisplayFlashDigits(args->board->screen, 0, 3, 0);
+    for (uint8_t i = 0; i < 4; i++) {
+        DisplayFlashDot(args->board->screen, i, 0, false);
+    }
+    ScreenScrollText(args->board->screen, text, MESSAGE_FRAME_MS / SCREEN_SWEEP_MS);
+
+    // La hora vuelve cuando el texto y el espacio que lo separa de su repetición pasaron una vez por la pantalla
+    message_start = xTaskGetTickCount();
+    message_ticks = pdMS_TO_TICKS(MESSAGE_FRAME_MS * (length + 1));
+    message_active = true;
+}
+
+static void ShowDateMessage(time_task_args_t args) {
+    clock_date_t date;
+    char text[] = "dd-mm-aaaa";
+
+    if (ClockGetDate(args->clock, &date)) {
+        text[0] = '0' + date.day / 10;
+        text[1] = '0' + date.day % 10;
+        text[3] = '0' + date.month / 10;
+        text[4] = '0' + date.month % 10;
+        text[6] = '0' + date.year / 1000;
+        text[7] = '0' + (date.year / 100) % 10;
+        text[8] = '0' + (date.year / 10) % 10;
+        text[9] = '0' + date.year % 10;
+        ShowMessage(args, text, sizeof(text) - 1);
+    }
+}
+
+static void ShowAlarmMessage(time_task_args_t args) {
+    clock_time_t alarm;
+    char text[] = "ALAR hh-mm"; // La M y los dos puntos no se pueden formar con siete segmentos
+
+    if (alarm_configured) {
+        ClockGetAlarm(args->clock, &alarm);
+        text[5] = '0' + alarm.bcd[5];
+        text[6] = '0' + alarm.bcd[4];
+        text[8] = '0' + alarm.bcd[3];
+        text[9] = '0' + alarm.bcd[2];
+        ShowMessage(args, text, sizeof(text) - 1);
+    }
+}
+
+static void ShowChrono(time_task_args_t args, uint32_t milliseconds) {
+    uint32_t high;
+    uint32_t low;
+    uint8_t digits[4];
+
+    if (milliseconds < 60000) {
+        high = milliseconds / 1000; // Segundos y centésimas durante el primer minuto
+        low = (milliseconds / 10) % 100;
+    } else if (milliseconds < 6000000) {
+        high = milliseconds / 60000; // Minutos y segundos hasta los 100 minutos
+        low = (milliseconds / 1000) % 60;
+    } else {
+        high = (milliseconds / 3600000) % 100; // Horas y minutos en adelante
+        low = (milliseconds / 60000) % 60;
+    }
+    digits[0] = low % 10;
+    digits[1] = low / 10;
+    digits[2] = high % 10;
+    digits[3] = high / 10;
+    ScreenWriteBCD(args->board->screen, digits, 4);
+}
+
+static void CountdownExpired(void * context) {
+    time_task_args_t args = context;
+
+    xEventGroupSetBits(args->event_group, args->timer_expired);
+}
+
+static void AdjustTimeout(TimerHandle_t timer) {
+    time_task_args_t args = pvTimerGetTimerID(timer);
+
+    xEventGroupSetBits(args->event_group, args->timeout);
+}
+
+static TickType_t StateWait(clock_state_t state) {
+    switch (state) {
+    case STATE_SHOW_TIME:
+    case STATE_CONTROL_ALARM:
+        return pdMS_TO_TICKS(CLOCK_PERIOD_MS);
+    case STATE_STOPWATCH:
+    case STATE_COUNTDOWN:
+        return pdMS_TO_TICKS(CHRONO_PERIOD_MS);
+    default:
+        return portMAX_DELAY; // Los ajustes solo cambian con una tecla o al vencer el tiempo de espera
+    }
+}
+
+static void ChangeDate(clock_date_t * date, clock_state_t field, bool increment) {
+    uint8_t days;
+
+    if (field == STATE_ADJUST_DATE_DAY) {
+        days = ClockDaysInMonth(date->year, date->month);
+        if (increment) {
+            date->day = (date->day >= days) ? 1 : date->day + 1;
+        } else {
+            date->day = (date->day <= 1) ? days : date->day - 1;
+        }
+    } else if (field == STATE_ADJUST_DATE_MONTH) {
+        if (increment) {
+            date->month = (date->month >= 12) ? 1 : date->month + 1;
+        } else {
+            date->month = (date->month <= 1) ? 12 : date->month - 1;
+        }
+    } else {
+        if (increment) {
+            date->year = (date->year >= CLOCK_YEAR_MAX) ? CLOCK_YEAR_MIN : date->year + 1;
+        } else {
+            date->year = (date->year <= CLOCK_YEAR_MIN) ? CLOCK_YEAR_MAX : date->year - 1;
+        }
+    }
+
+    days = ClockDaysInMonth(date->year, date->month);
+    if (date->day > days) {
+        date->day = days; // Al cambiar el mes o el año el día queda dentro del mes
+    }
+}
+
 /* === Public function definitions ================================================================================= */
 
+bool MEFSetAlarm(clock_t clock, const clock_time_t * alarm) {
+    if (!ClockSetAlarm(clock, alarm)) {
+        return false;
+    }
+    alarm_configured = true;
+    MEFRequestSave();
+    return true;
+}
+
+void MEFRequestSave(void) {
+    settings_pending = true;
+}
+
 /* === Public function implementation ============================================================================== */
 
 void MEFTask(void * pointer) {
@@ -74,49 +326,67 @@ void MEFTask(void * pointer) {
     clock_time_t hora;
 
     bool valid_time;
-    bool flanco_increment = true;
-    bool flanco_decrement = true;
-    bool flanco_accept = true;
-    bool flanco_cancel = true;
     bool alarm_is_active = false;
+    settings_t settings;
+    uint8_t saved_minute = 0xFF;
+    uint32_t lap_ms = 0;
+    uint32_t lap_ticks = 0;
+    clock_state_t previous_state;
+    TickType_t wait = 0;
 
     DigitalOutputDeactivate(args->board->led_R);
+    ClockCountdownOnExpire(args->clock, CountdownExpired, args);
+
+    // El vencimiento llega como un evento más, así los ajustes pueden esperar las teclas sin consultar el tiempo
+    adjust_timer = xTimerCreate("Adjust", pdMS_TO_TICKS(ADJUST_TIMEOUT_MS), pdFALSE, args, AdjustTimeout);
+    configASSERT(adjust_timer != NULL);
+
+    if (SettingsLoad(&settings)) { // El reloj ya fue restaurado durante el arranque
+        alarm_configured = settings.alarm_valid;
+        alarm_is_active = settings.alarm_enabled;
+    }
 
     while (1) {
-        xEventGroupClearBits(args->event_group, args->accept | args->cancel | args->increment | args->decrement |
-                                                    args->set_time | args->set_alarm);
+        // Solo se borran los eventos entregados, una tecla pulsada durante una pasada larga se atiende en la siguiente
         events = xEventGroupWaitBits(args->event_group,
                                      args->accept | args->cancel | args->increment | args->decrement | args->set_time |
-                                         args->set_alarm,
-                                     pdTRUE, pdFALSE, pdMS_TO_TICKS(1));
+                                         args->set_alarm | args->timer_expired | args->timeout,
+                                     pdTRUE, pdFALSE, wait);
 
         ticks = xTaskGetTickCount();
+        previous_state = current_state;
+
+        if ((events & args->timer_expired) && !alarm_sounding) {
+            BuzzerPlay(&COUNTDOWN_MELODY, COUNTDOWN_VOLUME, false); // Avisar en cualquier estado, sin esperar
+        }
 
         switch (current_state) {
             /*-------------------Funcionamiento Normal-------------------------------------------*/
         case STATE_SHOW_TIME:
             valid_time = ClockGetTime(args->clock, &hora);
-            ScreenWriteBCD(args->board->screen, hora.bcd, 4);
-
-            if (valid_time) {
-                DisplayFlashDigits(args->board->screen, 0, 3, 0);
+            if (message_active && (((ticks - message_start) >= message_ticks) || ClockAlarmIsRinging(args->clock))) {
+                message_active = false; // El mensaje terminó de pasar o lo interrumpe la alarma
+            }
+            if (!message_active) {
+                ScreenWriteBCD(args->board->screen, &hora.bcd[2], 4);
+                DisplayFlashDigits(args->board->screen, 0, 3, valid_time ? 0 : 100);
                 DisplayFlashDot(args->board->screen, 0, 100, false);
                 DisplayFlashDot(args->board->screen, 1, 100, true);
                 DisplayFlashDot(args->board->screen, 2, 100, false);
+                DisplayFlashDot(args->board->screen, 3, 0, valid_time && alarm_is_active);
+            }
+
+            if (settings_pending || (valid_time && (hora.time.minutes[0] != saved_minute))) {
+                settings_pending = false;
+                saved_minute = hora.time.minutes[0];
+                SaveSettings(args, alarm_is_active); // Guardar la hora una vez por minuto
+            }
+
+            if (valid_time) {
+                ClockSetStateAlarm(args->clock, alarm_is_active);
                 if (alarm_is_active) {
-                    DisplayFlashDot(args->board->screen, 3, 0, true);
-                    ClockSetStateAlarm(args->clock, true);
                     current_state = STATE_CONTROL_ALARM;
-                } else {
-                    DisplayFlashDot(args->board->screen, 3, 100, false);
-                    ClockSetStateAlarm(args->clock, false);
                 }
-            } else {
-                DisplayFlashDigits(args->board->screen, 0, 3, 100);
-                DisplayFlashDot(args->board->screen, 0, 100, false);
-                DisplayFlashDot(args->board->screen, 1, 100, true);
-                DisplayFlashDot(args->board->screen, 2, 100, false);
-                DisplayFlashDot(args->board->screen, 3, 100, false);
             }
 
             if (events & args->set_time) {
@@ -132,26 +402,28 @@ void MEFTask(void * pointer) {
 
             if (adjusting_time) {
                 current_state = STATE_ADJUST_TIME_MINUTES;
-                last_activity_ticks_time = ticks;
+                xTimerReset(adjust_timer, 0);
             }
             if (adjusting_alarm) {
                 current_state = STATE_ADJUST_ALARM_MINUTES;
-                last_activity_ticks_alarm = ticks;
+                xTimerReset(adjust_timer, 0);
             }
 
-            if (!(events & args->accept)) {
-                flanco_accept = true;
-            }
-            if (((events & args->accept) && flanco_accept) && !ClockAlarmIsRinging(args->clock)) {
+            if ((events & args->accept) && !ClockAlarmIsRinging(args->clock)) {
                 alarm_is_active = true;
-                flanco_accept = false;
-            }
-            if (!(events & args->cancel)) {
-                flanco_cancel = true;
+                SaveSettings(args, alarm_is_active);
+                ShowAlarmMessage(args); // Confirmar a qué hora va a sonar
             }
-            if (((events & args->cancel) && flanco_cancel) && !ClockAlarmIsRinging(args->clock)) {
+            if ((events & args->cancel) && !ClockAlarmIsRinging(args->clock)) {
                 alarm_is_active = false;
-                flanco_cancel = false;
+                SaveSettings(args, alarm_is_active);
+            }
+
+            if (events & args->increment) {
+                current_state = STATE_STOPWATCH;
+            }
+            if (events & args->decrement) {
+                current_state = STATE_COUNTDOWN;
             }
 
             break;
@@ -159,37 +431,25 @@ void MEFTask(void * pointer) {
             /*-------------------Puesta en Hora------------------------------------------------*/
         case STATE_ADJUST_TIME_MINUTES:
             if (adjusting_time) {
-                ScreenWriteBCD(args->board->screen, editable_time.bcd, 4);
+                ScreenWriteBCD(args->board->screen, &editable_time.bcd[2], 4);
                 DisplayFlashDigits(args->board->screen, 2, 3, 100);
 
-                if (!(events & args->increment)) {
-                    flanco_increment = true;
-                }
-                if ((events & args->increment) && flanco_increment) {
+                if (events & args->increment) {
                     IncrementMinutes(&editable_time);
-                    last_activity_ticks_time = ticks;
-                    flanco_increment = false;
+                    xTimerReset(adjust_timer, 0);
                 }
 
-                if (!(events & args->decrement)) {
-                    flanco_decrement = true;
-                }
-                if ((events & args->decrement) && flanco_decrement) {
+                if (events & args->decrement) {
                     DecrementMinutes(&editable_time);
-                    last_activity_ticks_time = ticks;
-                    flanco_decrement = false;
+                    xTimerReset(adjust_timer, 0);
                 }
 
-                if (!(events & args->accept)) {
-                    flanco_accept = true;
-                }
-                if ((events & args->accept) && flanco_accept) {
+                if (events & args->accept) {
                     current_state = STATE_ADJUST_TIME_HOURS;
-                    last_activity_ticks_time = ticks;
-                    flanco_accept = false;
+                    xTimerReset(adjust_timer, 0);
                 }
 
-                if (ticks - last_activity_ticks_time >= pdMS_TO_TICKS(30000)) {
+                if (events & args->timeout) {
                     adjusting_time = false;
                 }
             }
@@ -201,43 +461,85 @@ void MEFTask(void * pointer) {
 
         case STATE_ADJUST_TIME_HOURS:
             if (adjusting_time) {
-                ScreenWriteBCD(args->board->screen, editable_time.bcd, 4);
+                ScreenWriteBCD(args->board->screen, &editable_time.bcd[2], 4);
                 DisplayFlashDigits(args->board->screen, 0, 1, 100);
 
-                if (!(events & args->increment)) {
-                    flanco_increment = true;
-                }
-                if ((events & args->increment) && flanco_increment) {
+                if (events & args->increment) {
                     IncrementHours(&editable_time);
-                    last_activity_ticks_time = ticks;
-                    flanco_increment = false;
+                    xTimerReset(adjust_timer, 0);
                 }
 
-                if (!(events & args->decrement)) {
-                    flanco_decrement = true;
-                }
-                if ((events & args->decrement) && flanco_decrement) {
+                if (events & args->decrement) {
                     DecrementHours(&editable_time);
-                    last_activity_ticks_time = ticks;
-                    flanco_decrement = false;
+                    xTimerReset(adjust_timer, 0);
                 }
 
-                if (!(events & args->accept)) {
-                    flanco_accept = true;
-                }
-                if ((events & args->accept) && flanco_accept) {
+                if (events & args->accept) {
                     editable_time.time.seconds[0] = 0; // Aseguramos que los segundos sean 00
                     editable_time.time.seconds[1] = 0;
                     ClockSetTime(args->clock, &editable_time);
-                    current_state = STATE_SHOW_TIME;
+                    SaveSettings(args, alarm_is_active);
+                    ClockGetDate(args->clock, &editable_date); // Después de la hora se ajusta la fecha
+                    current_state = STATE_ADJUST_DATE_DAY;
+                    xTimerReset(adjust_timer, 0);
+                }
+
+                if (events & args->timeout) {
                     adjusting_time = false;
                 }
+            }
+            if (!adjusting_time || (events & args->cancel)) {
+                current_state = STATE_SHOW_TIME;
+                adjusting_time = false;
+            }
+
+            break;
+
+            /*-------------------Puesta en Fecha-----------------------------------------------*/
+        case STATE_ADJUST_DATE_DAY:
+        case STATE_ADJUST_DATE_MONTH:
+        case STATE_ADJUST_DATE_YEAR:
+            if (adjusting_time) {
+                ShowDate(args, &editable_date, current_state == STATE_ADJUST_DATE_YEAR);
+                DotTurningOn(args->board->screen, 1, current_state != STATE_ADJUST_DATE_YEAR);
+                if (current_state == STATE_ADJUST_DATE_DAY) {
+                    ScreenFlashMask(args->board->screen, 0x03, 0x02, 100); // El punto separa el día del mes
+                } else if (current_state == STATE_ADJUST_DATE_MONTH) {
+                    ScreenFlashMask(args->board->screen, 0x0C, 0x02, 100);
+                } else {
+                    ScreenFlashMask(args->board->screen, 0x0F, 0x00, 100);
+                }
 
-                if (ticks - last_activity_ticks_time >= pdMS_TO_TICKS(30000)) {
+                if (events & args->increment) {
+                    ChangeDate(&editable_date, current_state, true);
+                    xTimerReset(adjust_timer, 0);
+                }
+
+                if (events & args->decrement) {
+                    ChangeDate(&editable_date, current_state, false);
+                    xTimerReset(adjust_timer, 0);
+                }
+
+                if (events & args->accept) {
+                    if (current_state == STATE_ADJUST_DATE_YEAR) {
+                        ClockSetDate(args->clock, &editable_date);
+                        SaveSettings(args, alarm_is_active);
+                        ShowDateMessage(args);
+                        current_state = STATE_SHOW_TIME;
+                        adjusting_time = false;
+                    } else {
+                        current_state = (current_state == STATE_ADJUST_DATE_DAY) ? STATE_ADJUST_DATE_MONTH
+                                                                                 : STATE_ADJUST_DATE_YEAR;
+                        xTimerReset(adjust_timer, 0);
+                    }
+                }
+
+                if (events & args->timeout) {
                     adjusting_time = false;
                 }
             }
             if (!adjusting_time || (events & args->cancel)) {
+                DisplayFlashDot(args->board->screen, 1, 100, true);
                 current_state = STATE_SHOW_TIME;
                 adjusting_time = false;
             }
@@ -248,42 +550,30 @@ void MEFTask(void * pointer) {
         case STATE_ADJUST_ALARM_MINUTES:
             if (adjusting_alarm) {
 
-                DisplayFlashDot(args->board->screen, 0, 100, true);
-                DisplayFlashDot(args->board->screen, 1, 100, true);
-                DisplayFlashDot(args->board->screen, 2, 100, true);
-                DisplayFlashDot(args->board->screen, 3, 100, true);
-                DisplayFlashDigits(args->board->screen, 2, 3, 100);
+                for (uint8_t i = 0; i < 4; i++) {
+                    DotTurningOn(args->board->screen, i, true);
+                }
+                // Los cuatro puntos parpadean en fase con los minutos, lo que distingue el ajuste de la alarma
+                ScreenFlashMask(args->board->screen, 0x0C, 0x0F, 100);
 
-                ScreenWriteBCD(args->board->screen, editable_alarm.bcd, 4);
+                ScreenWriteBCD(args->board->screen, &editable_alarm.bcd[2], 4);
 
-                if (!(events & args->increment)) {
-                    flanco_increment = true;
-                }
-                if ((events & args->increment) && flanco_increment) {
+                if (events & args->increment) {
                     IncrementMinutes(&editable_alarm);
-                    last_activity_ticks_alarm = ticks;
-                    flanco_increment = false;
+                    xTimerReset(adjust_timer, 0);
                 }
 
-                if (!(events & args->decrement)) {
-                    flanco_decrement = true;
-                }
-                if ((events & args->decrement) && flanco_decrement) {
+                if (events & args->decrement) {
                     DecrementMinutes(&editable_alarm);
-                    last_activity_ticks_alarm = ticks;
-                    flanco_decrement = false;
+                    xTimerReset(adjust_timer, 0);
                 }
 
-                if (!(events & args->accept)) {
-                    flanco_accept = true;
-                }
-                if ((events & args->accept) && flanco_accept) {
+                if (events & args->accept) {
                     current_state = STATE_ADJUST_ALARM_HOURS;
-                    last_activity_ticks_alarm = ticks;
-                    flanco_accept = false;
+                    xTimerReset(adjust_timer, 0);
                 }
 
-                if (ticks - last_activity_ticks_alarm >= pdMS_TO_TICKS(30000)) {
+                if (events & args->timeout) {
                     adjusting_alarm = false;
                 }
             }
@@ -296,39 +586,70 @@ void MEFTask(void * pointer) {
         case STATE_ADJUST_ALARM_HOURS:
             if (adjusting_alarm) {
 
-                ScreenWriteBCD(args->board->screen, editable_alarm.bcd, 4);
-                DisplayFlashDigits(args->board->screen, 0, 1, 100);
+                ScreenWriteBCD(args->board->screen, &editable_alarm.bcd[2], 4);
+                ScreenFlashMask(args->board->screen, 0x03, 0x0F, 100);
 
-                if (!(events & args->increment)) {
-                    flanco_increment = true;
-                }
-                if ((events & args->increment) && flanco_increment) {
+                if (events & args->increment) {
                     IncrementHours(&editable_alarm);
-                    last_activity_ticks_alarm = ticks;
-                    flanco_increment = false;
+                    xTimerReset(adjust_timer, 0);
                 }
 
-                if (!(events & args->decrement)) {
-                    flanco_decrement = true;
-                }
-                if ((events & args->decrement) && flanco_decrement) {
+                if (events & args->decrement) {
                     DecrementHours(&editable_alarm);
-                    last_activity_ticks_alarm = ticks;
-                    flanco_decrement = false;
+                    xTimerReset(adjust_timer, 0);
                 }
 
-                if (!(events & args->accept)) {
-                    flanco_accept = true;
-                }
-                if ((events & args->accept) && flanco_accept) {
+                if (events & args->accept) {
                     editable_alarm.time.seconds[0] = 0; // Aseguramos que los segundos sean 00
                     editable_alarm.time.seconds[1] = 0;
                     ClockSetAlarm(args->clock, &editable_alarm);
+                    alarm_configured = true;
+                    SaveSettings(args, alarm_is_active);
+                    editable_alarm_days = 0;
+                    for (uint8_t i = 0; i < ALARM_DAYS_OPTIONS; i++) {
+                        if (ALARM_DAYS[i].days == ClockGetAlarmDays(args->clock)) {
+                            editable_alarm_days = i; // Comenzar por la opción configurada
+                        }
+                    }
+                    current_state = STATE_ADJUST_ALARM_DAYS;
+                    xTimerReset(adjust_timer, 0);
+                }
+
+                if (events & args->timeout) {
+                    adjusting_alarm = false;
+                }
+            }
+            if (!adjusting_alarm || (events & args->cancel)) {
+                current_state = STATE_SHOW_TIME;
+                adjusting_alarm = false;
+            }
+
+            break;
+
+        case STATE_ADJUST_ALARM_DAYS:
+            if (adjusting_alarm) {
+                ShowAlarmDays(args, editable_alarm_days);
+                DisplayFlashDigits(args->board->screen, 0, 3, 100);
+
+                if (events & args->increment) {
+                    editable_alarm_days = (editable_alarm_days + 1) % ALARM_DAYS_OPTIONS;
+                    xTimerReset(adjust_timer, 0);
+                }
+
+                if (events & args->decrement) {
+                    editable_alarm_days = (editable_alarm_days + ALARM_DAYS_OPTIONS - 1) % ALARM_DAYS_OPTIONS;
+                    xTimerReset(adjust_timer, 0);
+                }
+
+                if (events & args->accept) {
+                    ClockSetAlarmDays(args->clock, ALARM_DAYS[editable_alarm_days].days);
+                    SaveSettings(args, alarm_is_active);
+                    ShowAlarmMessage(args);
                     current_state = STATE_SHOW_TIME;
                     adjusting_alarm = false;
                 }
 
-                if (ticks - last_activity_ticks_alarm >= pdMS_TO_TICKS(30000)) {
+                if (events & args->timeout) {
                     adjusting_alarm = false;
                 }
             }
@@ -343,29 +664,131 @@ void MEFTask(void * pointer) {
         case STATE_CONTROL_ALARM:
             if (ClockAlarmIsRinging(args->clock) && alarm_is_active) {
                 DigitalOutputActivate(args->board->led_R);
+                if (!alarm_sounding) {
+                    BuzzerAlarmStart(); // La secuencia de sonido avanza sola en la interrupción del temporizador
+                    alarm_sounding = true;
+                }
             } else if (!ClockAlarmIsRinging(args->clock) || !alarm_is_active) {
                 DigitalOutputDeactivate(args->board->led_R);
+                if (alarm_sounding) {
+                    BuzzerStop(); // Solo el sonido de la alarma, el aviso de la cuenta regresiva termina solo
+                    alarm_sounding = false;
+                }
             }
 
-            if (!(events & args->accept)) {
-                flanco_accept = true;
-            }
-            if ((events & args->accept) && flanco_accept) {
+            if (events & args->accept) {
                 ClockPostponeAlarmRandomMinutes(args->clock, 5);
-                flanco_accept = false;
+                BuzzerStop();
+                alarm_sounding = false;
             }
 
-            if (!(events & args->cancel)) {
-                flanco_cancel = true;
-            }
-            if ((events & args->cancel) && flanco_cancel) {
+            if (events & args->cancel) {
                 ClockPostponeAlarmOneDay(args->clock);
                 DigitalOutputDeactivate(args->board->led_R);
-                flanco_cancel = false;
+                BuzzerStop();
+                alarm_sounding = false;
             }
 
             current_state = STATE_SHOW_TIME;
             break;
+
+            /*-------------------Cronómetro-----------------------------------------------------*/
+        case STATE_STOPWATCH:
+            if (ticks - lap_ticks < pdMS_TO_TICKS(LAP_SHOW_MS)) {
+                ShowChrono(args, lap_ms); // La vuelta tomada queda congelada unos segundos
+            } else {
+                ShowChrono(args, ClockStopwatchRead(args->clock));
+            }
+            DisplayFlashDigits(args->board->screen, 0, 3, ClockStopwatchIsRunning(args->clock) ? 0 : 100);
+            DisplayFlashDot(args->board->screen, 1, 0, true);
+
+            if (events & args->accept) {
+                ClockStopwatchRun(args->clock, !ClockStopwatchIsRunning(args->clock));
+            }
+
+            if (events & args->increment) {
+                if (ClockStopwatchIsRunning(args->clock)) {
+                    lap_ms = ClockStopwatchLap(args->clock);
+                    lap_ticks = ticks;
+                }
+            }
+
+            if (events & args->decrement) {
+                if (!ClockStopwatchIsRunning(args->clock)) {
+                    ClockStopwatchReset(args->clock);
+                    lap_ticks = ticks - pdMS_TO_TICKS(LAP_SHOW_MS);
+                }
+            }
+
+            // Al salir el cronómetro sigue en marcha; la alarma se atiende aunque se esté usando
+            if ((events & args->cancel) || (alarm_is_active && ClockAlarmIsRinging(args->clock))) {
+                DisplayFlashDigits(args->board->screen, 0, 3, 0);
+                current_state = STATE_SHOW_TIME;
+            }
+            break;
+
+            /*-------------------Cuenta Regresiva-----------------------------------------------*/
+        case STATE_COUNTDOWN:
+            if (ClockCountdownIsRunning(args->clock) || (ClockCountdownRead(args->clock) != 0)) {
+                ShowChrono(args, ClockCountdownRead(args->clock));
+                DisplayFlashDigits(args->board->screen, 0, 3, ClockCountdownIsRunning(args->clock) ? 0 : 100);
+            } else {
+                ShowChrono(args, countdown_minutes * 60000UL); // Duración a elegir antes de arrancar
+                DisplayFlashDigits(args->board->screen, 0, 1, 100);
+            }
+            DisplayFlashDot(args->board->screen, 1, 0, true);
+
+            if (events & args->accept) {
+                if (ClockCountdownRead(args->clock) == 0) {
+                    ClockCountdownSet(args->clock, countdown_minutes * 60000UL);
+                }
+                ClockCountdownRun(args->clock, !ClockCountdownIsRunning(args->clock));
+            }
+
+            if (events & args->increment) {
+                if (ClockCountdownRead(args->clock) == 0) {
+                    countdown_minutes = (countdown_minutes >= COUNTDOWN_MAX_MINUTE) ? 1 : countdown_minutes + 1;
+                }
+            }
+
+            if (events & args->decrement) {
+                if (ClockCountdownRead(args->clock) == 0) {
+                    countdown_minutes = (countdown_minutes <= 1) ? COUNTDOWN_MAX_MINUTE : countdown_minutes - 1;
+                } else if (!ClockCountdownIsRunning(args->clock)) {
+                    ClockCountdownSet(args->clock, 0); // Descartar una cuenta detenida
+                }
+            }
+
+            if ((events & args->cancel) || (alarm_is_active && ClockAlarmIsRinging(args->clock))) {
+                DisplayFlashDigits(args->board->screen, 0, 3, 0);
+                current_state = STATE_SHOW_TIME;
+            }
+            break;
+        }
+
+        if (current_state != previous_state) {
+            TraceRecord(TRACE_EVENT_STATE, previous_state, current_state);
+        }
+
+        if ((current_state != STATE_SHOW_TIME) && (current_state != STATE_CONTROL_ALARM)) {
+            message_active = false; // Los demás estados escriben la pantalla y detienen el mensaje
+        }
+
+        if ((current_state == STATE_SHOW_TIME) && xTimerIsTimerActive(adjust_timer)) {
+            xTimerStop(adjust_timer, 0); // Terminó el ajuste antes de vencer el tiempo de espera
+        }
+
+        // Solo mostrar la hora no necesita la frecuencia máxima; cualquier tecla despierta a la MEF y la sube
+        if (((current_state == STATE_SHOW_TIME) || (current_state == STATE_CONTROL_ALARM)) && !alarm_sounding &&
+            !BuzzerIsPlaying()) {
+            PowerSetMode(POWER_MODE_DISPLAY);
+        } else {
+            PowerSetMode(POWER_MODE_ACTIVE);
+        }
+
+        wait = StateWait(current_state);
+        if ((wait == portMAX_DELAY) && (events || (current_state != previous_state))) {
+            wait = 0; // Una pasada más para mostrar lo que cambió antes de quedar esperando
         }
     }
 }
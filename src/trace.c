@@ -0,0 +1,95 @@
+/*********************************************************************************************************************
+Copyright (c) 2025, Martín Fernando Gareca del autor <mfgareca36@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*********************************************************************************************************************/
+
+/** @file trace.c
+ ** @brief Implementación del registro binario de eventos del sistema operativo y de la aplicación
+ **/
+
+/* === Headers files inclusions ==================================================================================== */
+
+#include "trace.h"
+#include "ramfunc.h"
+#include "chip.h"
+
+/* === Macros definitions ========================================================================================== */
+
+#if (TRACE_BUFFER_RECORDS & (TRACE_BUFFER_RECORDS - 1)) != 0
+#error "TRACE_BUFFER_RECORDS debe ser una potencia de dos"
+#endif
+
+/* === Private data type declarations ============================================================================== */
+
+/* === Private function declarations =============================================================================== */
+
+/* === Private variable definitions ================================================================================ */
+
+//! Sin inicializar, en .bss: la imagen de 8 KB no ocupa la flash y el arranque solo la llena con ceros
+static trace_log_t trace_log;
+
+/* === Public variable definitions ================================================================================= */
+
+/* === Private function definitions ================================================================================ */
+
+/* === Public function definitions ================================================================================= */
+
+void TraceInit(void) {
+    // Solo el encabezado, los registros valen recién cuando head los alcanza
+    trace_log.magic = TRACE_MAGIC;
+    trace_log.version = TRACE_VERSION;
+    trace_log.size = TRACE_BUFFER_RECORDS;
+    trace_log.head = 0;
+    trace_log.core_mhz = 0;
+    trace_log.mask = TRACE_ALL_EVENTS;
+}
+
+__ramfunc void TraceRecord(uint8_t event, uint8_t arg8, uint16_t arg16) {
+    trace_record_t * record;
+    uint32_t primask;
+
+    if (!(trace_log.mask & (1UL << event))) {
+        return;
+    }
+
+    primask = __get_PRIMASK(); /**< Puede llamarse con las interrupciones ya enmascaradas */
+    __disable_irq();
+    record = &trace_log.records[trace_log.head & (TRACE_BUFFER_RECORDS - 1)];
+    trace_log.head++;
+    record->cycles = DWT->CYCCNT;
+    record->event = event;
+    record->arg8 = arg8;
+    record->arg16 = arg16;
+    __set_PRIMASK(primask);
+}
+
+void TraceClock(uint32_t hz) {
+    uint32_t previous = trace_log.core_mhz;
+
+    trace_log.core_mhz = hz / 1000000;
+    TraceRecord(TRACE_EVENT_CLOCK, previous, trace_log.core_mhz);
+}
+
+void TraceSetMask(uint32_t mask) {
+    trace_log.mask = mask;
+}
+
+const trace_log_t * TraceGetLog(void) {
+    return &trace_log;
+}
+
+/* === End of documentation ======================================================================================== */
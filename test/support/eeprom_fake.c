@@ -0,0 +1,96 @@
+/*********************************************************************************************************************
+Copyright (c) 2025, Martín Fernando Gareca del autor <mfgareca36@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*********************************************************************************************************************/
+
+
+/** @file eeprom_fake.c
+ ** @brief Memoria persistente simulada en el host, capaz de cortar la alimentación en cualquier byte
+ **/
+
+/* === Headers files inclusions ==================================================================================== */
+
+#include "eeprom_fake.h"
+#include <string.h>
+
+/* === Macros definitions ========================================================================================== */
+
+/* === Private data type declarations ============================================================================== */
+
+/* === Private function declarations =============================================================================== */
+
+static void Read(uint32_t offset, void * data, uint32_t size);
+
+static bool Write(uint32_t offset, const void * data, uint32_t size);
+
+/* === Private variable definitions ================================================================================ */
+
+static const struct settings_storage_s storage = {
+    .size = EEPROM_FAKE_SIZE,
+    .Read = Read,
+    .Write = Write,
+};
+
+static uint32_t budget; /**< Bytes que se pueden escribir antes del corte de alimentación */
+
+static uint32_t last_size; /**< Bytes pedidos en la última escritura */
+
+/* === Public variable definitions ================================================================================= */
+
+uint8_t eeprom_fake[EEPROM_FAKE_SIZE];
+
+/* === Private function definitions ================================================================================ */
+
+static void Read(uint32_t offset, void * data, uint32_t size) {
+    memcpy(data, &eeprom_fake[offset], size);
+}
+
+static bool Write(uint32_t offset, const void * data, uint32_t size) {
+    const uint8_t * bytes = data;
+    uint32_t index;
+
+    last_size = size;
+    for (index = 0; index < size; index++) {
+        if (budget == 0) {
+            return false; /**< Sin alimentación, el resto del registro queda como estaba */
+        }
+        if (budget != EEPROM_FAKE_NO_CUT) {
+            budget--;
+        }
+        eeprom_fake[offset + index] = bytes[index];
+    }
+    return true;
+}
+
+/* === Public function definitions ================================================================================= */
+
+settings_storage_t EepromFakeCreate(void) {
+    memset(eeprom_fake, EEPROM_FAKE_ERASED, sizeof(eeprom_fake));
+    budget = EEPROM_FAKE_NO_CUT;
+    last_size = 0;
+    return &storage;
+}
+
+void EepromFakeCutAfter(uint32_t bytes) {
+    budget = bytes;
+}
+
+uint32_t EepromFakeLastWriteSize(void) {
+    return last_size;
+}
+
+/* === End of documentation ======================================================================================== */
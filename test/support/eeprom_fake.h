@@ -0,0 +1,77 @@
+/*********************************************************************************************************************
+Copyright (c) 2025, Martín Fernando Gareca del autor <mfgareca36@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*********************************************************************************************************************/
+
+
+#ifndef EEPROM_FAKE_H_
+#define EEPROM_FAKE_H_
+
+/** @file eeprom_fake.h
+ ** @brief Memoria persistente simulada en el host, capaz de cortar la alimentación en cualquier byte
+ **/
+
+/* === Headers files inclusions ==================================================================================== */
+
+#include "settings.h"
+#include <stdint.h>
+
+/* === Header for C++ compatibility ================================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =================================================================================== */
+
+#define EEPROM_FAKE_SIZE   (8 * SETTINGS_SLOT_SIZE) /**< Tamaño de la memoria simulada */
+#define EEPROM_FAKE_ERASED 0xFF                     /**< Valor de los bytes nunca escritos */
+#define EEPROM_FAKE_NO_CUT UINT32_MAX               /**< Valor que deshabilita el corte de alimentación */
+
+/* === Public data type declarations =============================================================================== */
+
+/* === Public variable declarations ================================================================================ */
+
+extern uint8_t eeprom_fake[EEPROM_FAKE_SIZE]; /**< Contenido de la memoria, accesible para inspeccionarlo */
+
+/* === Public function declarations ================================================================================ */
+
+/**
+ * @brief Borra la memoria simulada y deshabilita el corte de alimentación.
+ * @return Memoria para pasar a SettingsInit.
+ */
+settings_storage_t EepromFakeCreate(void);
+
+/**
+ * @brief Programa un corte de alimentación.
+ * @param bytes Bytes que se escriben antes del corte, contados desde ahora. Los siguientes se descartan y la
+ *              escritura en curso informa un fallo.
+ */
+void EepromFakeCutAfter(uint32_t bytes);
+
+/**
+ * @brief Consulta cuántos bytes pidió escribir la última llamada a la función de escritura.
+ */
+uint32_t EepromFakeLastWriteSize(void);
+
+/* === End of conditional blocks =================================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EEPROM_FAKE_H_ */
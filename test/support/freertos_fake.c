@@ -0,0 +1,81 @@
+/*********************************************************************************************************************
+Copyright (c) 2025, Martín Fernando Gareca del autor <mfgareca36@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*********************************************************************************************************************/
+
+
+/** @file freertos_fake.c
+ ** @brief Funciones de FreeRTOS simuladas en el host, con un contador de ticks que avanza solo con las demoras
+ **/
+
+/* === Headers files inclusions ==================================================================================== */
+
+#include "freertos_fake.h"
+
+/* === Macros definitions ========================================================================================== */
+
+/* === Private data type declarations ============================================================================== */
+
+/* === Private function declarations =============================================================================== */
+
+/* === Private variable definitions ================================================================================ */
+
+static TickType_t ticks; /**< Ticks simulados desde FreeRTOSFakeReset */
+
+static uint32_t nesting; /**< Secciones críticas abiertas */
+
+static uint32_t entries; /**< Secciones críticas abiertas desde FreeRTOSFakeReset */
+
+/* === Public variable definitions ================================================================================= */
+
+/* === Private function definitions ================================================================================ */
+
+/* === Public function definitions ================================================================================= */
+
+void vTaskDelay(TickType_t delay) {
+    ticks += delay;
+}
+
+TickType_t xTaskGetTickCount(void) {
+    return ticks;
+}
+
+void vTaskEnterCritical(void) {
+    nesting++;
+    entries++;
+}
+
+void vTaskExitCritical(void) {
+    assert(nesting > 0);
+    nesting--;
+}
+
+void FreeRTOSFakeReset(void) {
+    ticks = 0;
+    nesting = 0;
+    entries = 0;
+}
+
+uint32_t FreeRTOSFakeCriticalNesting(void) {
+    return nesting;
+}
+
+uint32_t FreeRTOSFakeCriticalEntries(void) {
+    return entries;
+}
+
+/* === End of documentation ======================================================================================== */
@@ -0,0 +1,204 @@
+/*********************************************************************************************************************
+Copyright (c) 2025, Martín Fernando Gareca del autor <mfgareca36@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*********************************************************************************************************************/
+
+
+
+/** @file test_bcd.c
+ ** @brief Pruebas exhaustivas de las operaciones en paralelo sobre la hora BCD contra una versión escalar
+ **/
+
+/* === Headers files inclusions ==================================================================================== */
+
+#include "unity.h"
+#include "bcd.h"
+#include <string.h>
+
+/* === Macros definitions ========================================================================================== */
+
+#define DIGITS 6
+
+/* === Private data type declarations ============================================================================== */
+
+/* === Private variable definitions ================================================================================ */
+
+//! Máximo de cada dígito, desde las unidades de segundos hasta las decenas de horas
+static const uint8_t LIMITS[DIGITS] = {9, 5, 9, 5, 9, 2};
+
+/* === Private function declarations =============================================================================== */
+
+/* === Private function definitions ================================================================================ */
+
+//! Validación escalar, dígito por dígito
+static bool ScalarIsValid(const clock_time_t * time) {
+    uint8_t index;
+
+    for (index = 0; index < DIGITS; index++) {
+        if (time->bcd[index] > LIMITS[index]) {
+            return false;
+        }
+    }
+    return (time->bcd[5] * 10 + time->bcd[4]) < 24;
+}
+
+//! Conversión escalar a segundos desde la medianoche
+static uint32_t ScalarToSeconds(const clock_time_t * time) {
+    return (time->bcd[5] * 10 + time->bcd[4]) * 3600 + (time->bcd[3] * 10 + time->bcd[2]) * 60 + time->bcd[1] * 10 +
+           time->bcd[0];
+}
+
+//! Conversión escalar de segundos desde la medianoche a BCD
+static void ScalarFromSeconds(clock_time_t * time, uint32_t seconds) {
+    uint8_t fields[3] = {seconds % 60, (seconds / 60) % 60, seconds / 3600};
+    uint8_t index;
+
+    for (index = 0; index < 3; index++) {
+        time->bcd[2 * index] = fields[index] % 10;
+        time->bcd[2 * index + 1] = fields[index] / 10;
+    }
+}
+
+//! Arma una hora con un dígito por nibble de pattern, el primero en los bits menos significativos
+static void FromPattern(clock_time_t * time, uint32_t pattern) {
+    uint8_t index;
+
+    for (index = 0; index < DIGITS; index++) {
+        time->bcd[index] = (pattern >> (4 * index)) & 0x0F;
+    }
+}
+
+/* === Public function definitions ================================================================================= */
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+//! Todas las combinaciones de dígitos de 0 a 15 se validan igual que con la versión escalar
+void test_every_nibble_pattern_matches_scalar_validation(void) {
+    clock_time_t time;
+    uint32_t pattern;
+    uint32_t valid = 0;
+
+    for (pattern = 0; pattern < (1UL << (4 * DIGITS)); pattern++) {
+        FromPattern(&time, pattern);
+        if (BcdTimeIsValid(&time) != ScalarIsValid(&time)) {
+            TEST_FAIL_MESSAGE("La validación difiere de la versión escalar");
+        }
+        valid += ScalarIsValid(&time);
+    }
+    TEST_ASSERT_EQUAL(BCD_SECONDS_PER_DAY, valid);
+}
+
+//! Cualquier valor de byte en cada posición, con el resto de los dígitos válidos, se valida igual que con la escalar
+void test_every_byte_value_in_each_digit_matches_scalar_validation(void) {
+    static const clock_time_t EDGES[] = {{.bcd = {0, 0, 0, 0, 0, 0}}, {.bcd = {9, 5, 9, 5, 3, 2}}};
+    clock_time_t time;
+    uint8_t edge;
+    uint8_t index;
+    uint16_t value;
+
+    for (edge = 0; edge < sizeof(EDGES) / sizeof(EDGES[0]); edge++) {
+        for (index = 0; index < DIGITS; index++) {
+            for (value = 0; value <= UINT8_MAX; value++) {
+                time = EDGES[edge];
+                time.bcd[index] = value;
+                if (BcdTimeIsValid(&time) != ScalarIsValid(&time)) {
+                    TEST_FAIL_MESSAGE("La validación difiere de la versión escalar");
+                }
+            }
+        }
+    }
+}
+
+//! Las horas a las que les sobra un dígito alto, como 24:00:00 o 19:60:00, son inválidas
+void test_out_of_range_times_are_invalid(void) {
+    static const clock_time_t INVALID[] = {
+        {.bcd = {0, 0, 0, 0, 4, 2}}, {.bcd = {0, 0, 0, 6, 9, 1}}, {.bcd = {0, 6, 0, 0, 0, 0}},
+        {.bcd = {10, 0, 0, 0, 0, 0}}, {.bcd = {0, 0, 0, 0, 0, 3}}, {.bcd = {0x80, 0, 0, 0, 0, 0}},
+    };
+    uint8_t index;
+
+    for (index = 0; index < sizeof(INVALID) / sizeof(INVALID[0]); index++) {
+        TEST_ASSERT_FALSE(BcdTimeIsValid(&INVALID[index]));
+    }
+}
+
+//! El incremento en paralelo coincide con el escalar en todas las horas válidas, incluido el cambio de día
+void test_increment_matches_scalar_for_every_valid_time(void) {
+    clock_time_t time;
+    clock_time_t expected;
+    uint32_t seconds;
+    bool new_day;
+
+    for (seconds = 0; seconds < BCD_SECONDS_PER_DAY; seconds++) {
+        ScalarFromSeconds(&time, seconds);
+        ScalarFromSeconds(&expected, (seconds + 1) % BCD_SECONDS_PER_DAY);
+        new_day = BcdTimeIncrement(&time);
+        if ((memcmp(time.bcd, expected.bcd, DIGITS) != 0) || (new_day != (seconds == BCD_SECONDS_PER_DAY - 1))) {
+            TEST_FAIL_MESSAGE("El incremento difiere de la versión escalar");
+        }
+    }
+}
+
+//! Un día completo de incrementos recorre todas las horas y vuelve a la medianoche una sola vez
+void test_full_day_of_increments_returns_to_midnight(void) {
+    clock_time_t time = {0};
+    uint32_t seconds;
+    uint32_t days = 0;
+
+    for (seconds = 0; seconds < BCD_SECONDS_PER_DAY; seconds++) {
+        TEST_ASSERT_TRUE(BcdTimeIsValid(&time));
+        days += BcdTimeIncrement(&time);
+    }
+    TEST_ASSERT_EQUAL(1, days);
+    TEST_ASSERT_EQUAL(0, BcdTimeToSeconds(&time));
+}
+
+//! Las conversiones a segundos y desde segundos coinciden con las escalares en todas las horas válidas
+void test_seconds_conversions_match_scalar_for_every_valid_time(void) {
+    clock_time_t time;
+    clock_time_t expected;
+    uint32_t seconds;
+
+    for (seconds = 0; seconds < BCD_SECONDS_PER_DAY; seconds++) {
+        ScalarFromSeconds(&expected, seconds);
+        BcdTimeFromSeconds(&time, seconds);
+        if ((memcmp(time.bcd, expected.bcd, DIGITS) != 0) || (BcdTimeToSeconds(&expected) != seconds) ||
+            (ScalarToSeconds(&time) != seconds)) {
+            TEST_FAIL_MESSAGE("La conversión difiere de la versión escalar");
+        }
+    }
+}
+
+//! Los segundos fuera de un día se toman módulo un día
+void test_from_seconds_wraps_to_one_day(void) {
+    clock_time_t time;
+    clock_time_t expected;
+
+    BcdTimeFromSeconds(&time, BCD_SECONDS_PER_DAY + 61);
+    ScalarFromSeconds(&expected, 61);
+    TEST_ASSERT_EQUAL_MEMORY(expected.bcd, time.bcd, DIGITS);
+
+    BcdTimeFromSeconds(&time, UINT32_MAX);
+    ScalarFromSeconds(&expected, UINT32_MAX % BCD_SECONDS_PER_DAY);
+    TEST_ASSERT_EQUAL_MEMORY(expected.bcd, time.bcd, DIGITS);
+}
+
+/* === End of documentation ======================================================================================== */
@@ -0,0 +1,267 @@
+/*********************************************************************************************************************
+Copyright (c) 2025, Martín Fernando Gareca del autor <mfgareca36@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*********************************************************************************************************************/
+
+
+
+/** @file test_clock.c
+ ** @brief Pruebas del calendario del reloj a lo largo de todo el rango de años, con sus reglas de bisiestos, y del
+ **        cronómetro y la cuenta regresiva que avanzan con el tick
+ **/
+
+/* === Headers files inclusions ==================================================================================== */
+
+#include "unity.h"
+#include "clock.h"
+#include "bcd.h"
+
+/* === Macros definitions ========================================================================================== */
+
+/* === Private data type declarations ============================================================================== */
+
+/* === Private variable definitions ================================================================================ */
+
+static clock_t rtc;
+
+//! Un segundo antes de la medianoche
+static const clock_time_t LAST_SECOND = {.bcd = {9, 5, 9, 5, 3, 2}};
+
+//! Cantidad de avisos de fin de la cuenta regresiva recibidos
+static uint8_t expirations;
+
+/* === Private function declarations =============================================================================== */
+
+/* === Private function definitions ================================================================================ */
+
+//! Regla gregoriana escrita de otra forma que en el reloj, para no repetir un error
+static bool ReferenceIsLeap(uint16_t year) {
+    if ((year % 400) == 0) {
+        return true;
+    }
+    if ((year % 100) == 0) {
+        return false;
+    }
+    return (year % 4) == 0;
+}
+
+//! Días del mes según la regla de los nudillos
+static uint8_t ReferenceDaysInMonth(uint16_t year, uint8_t month) {
+    if (month == 2) {
+        return ReferenceIsLeap(year) ? 29 : 28;
+    }
+    return ((month == 4) || (month == 6) || (month == 9) || (month == 11)) ? 30 : 31;
+}
+
+//! Avanza el reloj de un día al siguiente pasando por la medianoche con los ticks de un segundo
+static void PassMidnight(void) {
+    ClockSetTime(rtc, &LAST_SECOND);
+    for (uint16_t tick = 0; tick < 1000; tick++) {
+        ClockNewTick(rtc);
+    }
+}
+
+//! Avanza el reloj la cantidad de ticks indicada
+static void Advance(uint32_t ticks) {
+    for (uint32_t tick = 0; tick < ticks; tick++) {
+        ClockNewTick(rtc);
+    }
+}
+
+//! Cuenta los avisos de fin de la cuenta regresiva y verifica el contexto entregado
+static void CountdownExpired(void * context) {
+    TEST_ASSERT_EQUAL_PTR(&expirations, context);
+    expirations++;
+}
+
+//! Establece una fecha y verifica que el reloj la haya aceptado
+static void SetDate(uint16_t year, uint8_t month, uint8_t day) {
+    clock_date_t date = {.year = year, .month = month, .day = day};
+    TEST_ASSERT_TRUE(ClockSetDate(rtc, &date));
+}
+
+/* === Public function definitions ================================================================================= */
+
+void setUp(void) {
+    rtc = ClockCreate();
+    expirations = 0;
+}
+
+void tearDown(void) {
+}
+
+//! Los bisiestos siguen las reglas del 4, del 100 y del 400 en todo el rango
+void test_leap_years_follow_century_rules(void) {
+    for (uint16_t year = CLOCK_YEAR_MIN; year <= CLOCK_YEAR_MAX; year++) {
+        TEST_ASSERT_EQUAL(ReferenceDaysInMonth(year, 2), ClockDaysInMonth(year, 2));
+    }
+    TEST_ASSERT_EQUAL(28, ClockDaysInMonth(1900, 2));
+    TEST_ASSERT_EQUAL(29, ClockDaysInMonth(2000, 2));
+    TEST_ASSERT_EQUAL(28, ClockDaysInMonth(2100, 2));
+    TEST_ASSERT_EQUAL(29, ClockDaysInMonth(2024, 2));
+    TEST_ASSERT_EQUAL(0, ClockDaysInMonth(2024, 13));
+}
+
+//! Días de la semana conocidos en distintos siglos
+void test_weekday_of_known_dates(void) {
+    TEST_ASSERT_EQUAL(1, ClockWeekday(1900, 1, 1));
+    TEST_ASSERT_EQUAL(6, ClockWeekday(2000, 1, 1));
+    TEST_ASSERT_EQUAL(2, ClockWeekday(2000, 2, 29));
+    TEST_ASSERT_EQUAL(3, ClockWeekday(2025, 1, 1));
+    TEST_ASSERT_EQUAL(1, ClockWeekday(2100, 3, 1));
+    TEST_ASSERT_EQUAL(5, ClockWeekday(2399, 12, 31));
+}
+
+//! Solo se aceptan fechas que existen dentro del rango de años
+void test_set_date_rejects_invalid_dates(void) {
+    clock_date_t date = {.year = 2100, .month = 2, .day = 29};
+
+    TEST_ASSERT_FALSE(ClockSetDate(rtc, &date));
+    date = (clock_date_t){.year = CLOCK_YEAR_MIN - 1, .month = 12, .day = 31};
+    TEST_ASSERT_FALSE(ClockSetDate(rtc, &date));
+    date = (clock_date_t){.year = CLOCK_YEAR_MAX + 1, .month = 1, .day = 1};
+    TEST_ASSERT_FALSE(ClockSetDate(rtc, &date));
+    date = (clock_date_t){.year = 2025, .month = 4, .day = 31};
+    TEST_ASSERT_FALSE(ClockSetDate(rtc, &date));
+    date = (clock_date_t){.year = 2025, .month = 13, .day = 1};
+    TEST_ASSERT_FALSE(ClockSetDate(rtc, &date));
+    TEST_ASSERT_FALSE(ClockSetDate(rtc, NULL));
+
+    date = (clock_date_t){.year = 2000, .month = 2, .day = 29};
+    TEST_ASSERT_TRUE(ClockSetDate(rtc, &date));
+}
+
+//! Cada medianoche entre el primer y el último año avanza un día del calendario y uno de la semana
+void test_every_midnight_across_the_whole_range(void) {
+    clock_date_t date;
+    clock_date_t expected;
+    uint32_t days = 1;
+
+    SetDate(CLOCK_YEAR_MIN, 1, 1);
+    ClockGetDate(rtc, &expected);
+    while ((expected.year != CLOCK_YEAR_MAX) || (expected.month != 12) || (expected.day != 31)) {
+        ClockSync(rtc, &LAST_SECOND, NULL, 1000); /**< Un segundo después de las 23:59:59 */
+
+        expected.weekday = (expected.weekday + 1) % 7;
+        if (++expected.day > ReferenceDaysInMonth(expected.year, expected.month)) {
+            expected.day = 1;
+            if (++expected.month > 12) {
+                expected.month = 1;
+                expected.year++;
+            }
+        }
+        ClockGetDate(rtc, &date);
+        if ((date.year != expected.year) || (date.month != expected.month) || (date.day != expected.day) ||
+            (date.weekday != expected.weekday)) {
+            TEST_FAIL_MESSAGE("La fecha difiere de la referencia");
+        }
+        days++;
+    }
+    TEST_ASSERT_EQUAL(182621, days); /**< 500 años con 121 bisiestos */
+    TEST_ASSERT_EQUAL(ClockWeekday(CLOCK_YEAR_MAX, 12, 31), expected.weekday);
+}
+
+//! El 29 de febrero de los años seculares solo existe cada 400 años
+void test_midnight_at_end_of_february_in_century_years(void) {
+    clock_date_t date;
+
+    SetDate(2000, 2, 28);
+    PassMidnight();
+    ClockGetDate(rtc, &date);
+    TEST_ASSERT_EQUAL(29, date.day);
+
+    SetDate(2100, 2, 28);
+    PassMidnight();
+    ClockGetDate(rtc, &date);
+    TEST_ASSERT_EQUAL(3, date.month);
+    TEST_ASSERT_EQUAL(1, date.day);
+    TEST_ASSERT_EQUAL(1, date.weekday);
+}
+
+//! Después del último día del rango el calendario vuelve al primero, con su día de la semana
+void test_end_of_range_wraps_to_first_year(void) {
+    clock_date_t date;
+    clock_time_t time;
+
+    SetDate(CLOCK_YEAR_MAX, 12, 31);
+    PassMidnight();
+
+    ClockGetDate(rtc, &date);
+    TEST_ASSERT_EQUAL(CLOCK_YEAR_MIN, date.year);
+    TEST_ASSERT_EQUAL(1, date.month);
+    TEST_ASSERT_EQUAL(1, date.day);
+    TEST_ASSERT_EQUAL(ClockWeekday(CLOCK_YEAR_MIN, 1, 1), date.weekday);
+
+    ClockGetTime(rtc, &time);
+    TEST_ASSERT_EQUAL(0, BcdTimeToSeconds(&time));
+}
+
+//! Configurar la alarma no da por ajustada la hora del reloj
+void test_alarm_does_not_validate_the_time(void) {
+    const clock_time_t alarm = {.bcd = {0, 0, 0, 3, 7, 0}};
+    clock_time_t result;
+
+    TEST_ASSERT_FALSE(ClockGetAlarm(rtc, &result));
+    TEST_ASSERT_TRUE(ClockSetAlarm(rtc, &alarm));
+    TEST_ASSERT_TRUE(ClockGetAlarm(rtc, &result));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(alarm.bcd, result.bcd, sizeof(alarm.bcd));
+    TEST_ASSERT_FALSE(ClockGetTime(rtc, &result));
+}
+
+//! El cronómetro suma un milisegundo por tick solo mientras está en marcha
+void test_stopwatch_counts_up_with_ticks(void) {
+    Advance(10);
+    TEST_ASSERT_EQUAL(0, ClockStopwatchRead(rtc));
+
+    ClockStopwatchRun(rtc, true);
+    Advance(1500);
+    TEST_ASSERT_EQUAL(1500, ClockStopwatchRead(rtc));
+    TEST_ASSERT_EQUAL(1500, ClockStopwatchLap(rtc));
+
+    Advance(250);
+    ClockStopwatchRun(rtc, false);
+    Advance(100);
+    TEST_ASSERT_EQUAL(1750, ClockStopwatchRead(rtc));
+    TEST_ASSERT_EQUAL(250, ClockStopwatchLap(rtc));
+
+    ClockStopwatchReset(rtc);
+    TEST_ASSERT_EQUAL(0, ClockStopwatchRead(rtc));
+}
+
+//! La cuenta regresiva llega a cero, se detiene y avisa una sola vez
+void test_countdown_reaches_zero_and_expires_once(void) {
+    ClockCountdownOnExpire(rtc, CountdownExpired, &expirations);
+    ClockCountdownSet(rtc, 2000);
+    TEST_ASSERT_FALSE(ClockCountdownIsRunning(rtc));
+    TEST_ASSERT_TRUE(ClockCountdownRun(rtc, true));
+
+    Advance(1999);
+    TEST_ASSERT_EQUAL(1, ClockCountdownRead(rtc));
+    TEST_ASSERT_EQUAL(0, expirations);
+
+    Advance(1);
+    TEST_ASSERT_EQUAL(0, ClockCountdownRead(rtc));
+    TEST_ASSERT_FALSE(ClockCountdownIsRunning(rtc));
+    TEST_ASSERT_EQUAL(1, expirations);
+
+    Advance(1000);
+    TEST_ASSERT_EQUAL(0, ClockCountdownRead(rtc));
+    TEST_ASSERT_EQUAL(1, expirations);
+    TEST_ASSERT_FALSE(ClockCountdownRun(rtc, true));
+}
+
+/* === End of documentation ======================================================================================== */
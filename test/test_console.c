@@ -0,0 +1,315 @@
+/*********************************************************************************************************************
+Copyright (c) 2025, Martín Fernando Gareca del autor <mfgareca36@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*********************************************************************************************************************/
+
+
+
+/** @file test_console.c
+ ** @brief Pruebas de la consola sobre un puerto simulado, con el buffer de recepción recorrido como lo llena el DMA
+ **/
+
+/* === Headers files inclusions ==================================================================================== */
+
+#include "unity.h"
+#include "console.h"
+#include "clock.h"
+#include "bcd.h"
+#include "freertos_fake.h"
+#include "mock_display.h"
+#include "mock_monitor.h"
+#include "mock_power.h"
+#include "mock_sync.h"
+#include "mock_timeMEF.h"
+#include "mock_trace.h"
+#include <string.h>
+
+/* === Macros definitions ========================================================================================== */
+
+#define OUTPUT_SIZE 2048
+
+/* === Private data type declarations ============================================================================== */
+
+/* === Private function declarations =============================================================================== */
+
+static uint16_t RxPosition(void);
+
+static void TxStart(const uint8_t * data, uint16_t size);
+
+static bool TxBusy(void);
+
+/* === Private variable definitions ================================================================================ */
+
+static uint8_t rx[CONSOLE_RX_SIZE];
+
+static uint16_t rx_position; /**< Como el DMA, de 0 a CONSOLE_RX_SIZE inclusive antes de recargar el descriptor */
+
+static char output[OUTPUT_SIZE];
+
+static uint16_t output_length;
+
+static clock_t rtc;
+
+static clock_time_t mef_alarm; /**< Última alarma recibida por la MEF */
+
+static int16_t utc_offset; /**< Diferencia con UTC fijada en la sincronización */
+
+static int saves; /**< Pedidos de guardar la configuración */
+
+static const struct console_port_s port = {
+    .rx_buffer = rx,
+    .RxPosition = RxPosition,
+    .TxStart = TxStart,
+    .TxBusy = TxBusy,
+};
+
+/* === Private function definitions ================================================================================ */
+
+static uint16_t RxPosition(void) {
+    return rx_position;
+}
+
+static void TxStart(const uint8_t * data, uint16_t size) {
+    TEST_ASSERT_TRUE(output_length + size < OUTPUT_SIZE);
+    memcpy(&output[output_length], data, size);
+    output_length += size;
+    output[output_length] = '\0';
+}
+
+static bool TxBusy(void) {
+    return false; /**< Cada bloque sale de inmediato */
+}
+
+//! Recibe un texto como lo escribiría el DMA, recargando el descriptor al llegar al final del buffer
+static void Receive(const char * text) {
+    while (*text != '\0') {
+        if (rx_position == CONSOLE_RX_SIZE) {
+            rx_position = 0;
+        }
+        rx[rx_position++] = (uint8_t)*text++;
+    }
+}
+
+//! Recibe una orden, la ejecuta y devuelve la respuesta sin el eco
+static const char * Command(const char * line) {
+    output_length = 0;
+    output[0] = '\0';
+    Receive(line);
+    ConsolePoll();
+    return output;
+}
+
+static bool FakeSetAlarm(clock_t clock, const clock_time_t * alarm, int calls) {
+    (void)calls;
+    mef_alarm = *alarm;
+    return ClockSetAlarm(clock, alarm);
+}
+
+static bool FakeSetUtcOffset(int16_t minutes, int calls) {
+    (void)calls;
+    if ((minutes < SYNC_UTC_OFFSET_MIN) || (minutes > SYNC_UTC_OFFSET_MAX)) {
+        return false;
+    }
+    utc_offset = minutes;
+    return true;
+}
+
+static int16_t FakeGetUtcOffset(int calls) {
+    (void)calls;
+    return utc_offset;
+}
+
+static void FakeRequestSave(int calls) {
+    (void)calls;
+    saves++;
+}
+
+static void AssertTime(const clock_time_t * time, uint8_t hours, uint8_t minutes, uint8_t seconds) {
+    TEST_ASSERT_EQUAL_UINT32(hours * 3600 + minutes * 60 + seconds, BcdTimeToSeconds(time));
+}
+
+/* === Public function definitions ================================================================================= */
+
+void setUp(void) {
+    memset(rx, 0, sizeof(rx));
+    rx_position = 0;
+    output_length = 0;
+    FreeRTOSFakeReset();
+    MEFSetAlarm_StubWithCallback(FakeSetAlarm);
+    MEFRequestSave_StubWithCallback(FakeRequestSave);
+    SyncSetUtcOffset_StubWithCallback(FakeSetUtcOffset);
+    SyncGetUtcOffset_StubWithCallback(FakeGetUtcOffset);
+    utc_offset = 0;
+    saves = 0;
+    rtc = ClockCreate();
+    ConsoleInit(&port, rtc);
+    ConsolePoll();
+}
+
+void tearDown(void) {
+}
+
+//! Al arrancar se anuncia por el puerto
+void test_banner_after_init(void) {
+    TEST_ASSERT_NOT_NULL(strstr(output, "reloj listo"));
+}
+
+//! La hora se ajusta y se consulta
+void test_set_and_show_time(void) {
+    clock_time_t time;
+
+    TEST_ASSERT_NOT_NULL(strstr(Command("hora 12:34:56\r"), "ok"));
+    TEST_ASSERT_TRUE(ClockGetTime(rtc, &time));
+    AssertTime(&time, 12, 34, 56);
+    TEST_ASSERT_NOT_NULL(strstr(Command("hora\r"), "12:34:56"));
+}
+
+//! La hora y la fecha se reemplazan dentro de una sección crítica, así el tick del servicio no las ve a medias
+void test_set_time_and_date_in_critical_section(void) {
+    uint32_t entries;
+
+    entries = FreeRTOSFakeCriticalEntries();
+    TEST_ASSERT_NOT_NULL(strstr(Command("hora 12:34\r"), "ok"));
+    TEST_ASSERT_GREATER_THAN_UINT32(entries, FreeRTOSFakeCriticalEntries());
+    TEST_ASSERT_EQUAL_UINT32(0, FreeRTOSFakeCriticalNesting());
+
+    entries = FreeRTOSFakeCriticalEntries();
+    TEST_ASSERT_NOT_NULL(strstr(Command("fecha 2024-02-29\r"), "ok"));
+    TEST_ASSERT_GREATER_THAN_UINT32(entries, FreeRTOSFakeCriticalEntries());
+    TEST_ASSERT_EQUAL_UINT32(0, FreeRTOSFakeCriticalNesting());
+}
+
+//! Una hora fuera de rango no cambia el reloj
+void test_invalid_time_is_rejected(void) {
+    clock_time_t time;
+
+    TEST_ASSERT_NOT_NULL(strstr(Command("hora 24:00\r"), "error"));
+    TEST_ASSERT_FALSE(ClockGetTime(rtc, &time));
+}
+
+//! La fecha se ajusta con su día de la semana
+void test_set_and_show_date(void) {
+    TEST_ASSERT_NOT_NULL(strstr(Command("fecha 2024-02-29\r"), "ok"));
+    TEST_ASSERT_NOT_NULL(strstr(Command("fecha\r"), "2024-02-29 jue"));
+    TEST_ASSERT_NOT_NULL(strstr(Command("fecha 2023-02-29\r"), "error"));
+}
+
+//! La alarma pasa por la MEF, que la marca como configurada para guardarla
+void test_alarm_goes_through_the_state_machine(void) {
+    MEFSetAlarm_calls = 0;
+    TEST_ASSERT_NOT_NULL(strstr(Command("alarma 07:30\r"), "ok"));
+    TEST_ASSERT_EQUAL_INT(1, MEFSetAlarm_calls);
+    AssertTime(&mef_alarm, 7, 30, 0);
+    TEST_ASSERT_NOT_NULL(strstr(Command("alarma\r"), "07:30"));
+}
+
+//! Una alarma con segundos no es válida
+void test_alarm_with_seconds_is_rejected(void) {
+    MEFSetAlarm_calls = 0;
+    TEST_ASSERT_NOT_NULL(strstr(Command("alarma 07:30:15\r"), "error"));
+    TEST_ASSERT_EQUAL_INT(0, MEFSetAlarm_calls);
+}
+
+//! La diferencia con UTC se ajusta con su signo y se guarda
+void test_set_and_show_utc_offset(void) {
+    TEST_ASSERT_NOT_NULL(strstr(Command("utc\r"), "+00:00"));
+    TEST_ASSERT_NOT_NULL(strstr(Command("utc -03:30\r"), "ok"));
+    TEST_ASSERT_EQUAL_INT16(-(3 * 60 + 30), utc_offset);
+    TEST_ASSERT_EQUAL_INT(1, saves);
+    TEST_ASSERT_NOT_NULL(strstr(Command("utc\r"), "-03:30"));
+    TEST_ASSERT_NOT_NULL(strstr(Command("utc +05:45\r"), "ok"));
+    TEST_ASSERT_EQUAL_INT16(5 * 60 + 45, utc_offset);
+}
+
+//! La diferencia necesita el signo, minutos válidos y estar dentro de los husos existentes
+void test_invalid_utc_offset_is_rejected(void) {
+    TEST_ASSERT_NOT_NULL(strstr(Command("utc 03:00\r"), "error"));
+    TEST_ASSERT_NOT_NULL(strstr(Command("utc +03:60\r"), "error"));
+    TEST_ASSERT_NOT_NULL(strstr(Command("utc +15:00\r"), "error"));
+    TEST_ASSERT_EQUAL_INT16(0, utc_offset);
+    TEST_ASSERT_EQUAL_INT(0, saves);
+}
+
+//! Las órdenes desconocidas se informan
+void test_unknown_command(void) {
+    TEST_ASSERT_NOT_NULL(strstr(Command("horas\r"), "orden desconocida"));
+}
+
+//! Una línea demasiado larga se descarta completa y la siguiente se interpreta normalmente
+void test_long_line_is_discarded(void) {
+    char line[CONSOLE_LINE_MAX + 16];
+
+    memset(line, 'x', sizeof(line) - 2);
+    line[sizeof(line) - 2] = '\r';
+    line[sizeof(line) - 1] = '\0';
+    TEST_ASSERT_NULL(strstr(Command(line), "orden desconocida"));
+    TEST_ASSERT_NOT_NULL(strstr(Command("hora 01:02\r"), "ok"));
+}
+
+//! Una orden puede llegar en varias lecturas del puerto
+void test_command_split_across_polls(void) {
+    TEST_ASSERT_NULL(strstr(Command("hora 0"), "ok"));
+    TEST_ASSERT_NOT_NULL(strstr(Command("8:09\r"), "ok"));
+}
+
+//! Una línea que cruza el final del buffer circular se interpreta sin copiarla
+void test_command_across_the_end_of_the_ring(void) {
+    clock_time_t time;
+
+    rx_position = CONSOLE_RX_SIZE - 5;
+    ConsoleInit(&port, rtc);
+    TEST_ASSERT_NOT_NULL(strstr(Command("hora 10:11:12\r"), "ok"));
+    TEST_ASSERT_TRUE(ClockGetTime(rtc, &time));
+    AssertTime(&time, 10, 11, 12);
+}
+
+//! El DMA informa el final del buffer antes de recargar el descriptor, la consola lo toma como el comienzo
+void test_init_with_the_position_at_the_end_of_the_ring(void) {
+    rx_position = CONSOLE_RX_SIZE;
+    ConsoleInit(&port, rtc);
+    ConsolePoll();
+    TEST_ASSERT_EQUAL_STRING("hora 03:04\r\nok\r\n", Command("hora 03:04\r")); /**< Eco completo, sin leer fuera */
+}
+
+//! Lo recibido antes de arrancar no se interpreta
+void test_input_before_init_is_ignored(void) {
+    Receive("hora 05:06\r");
+    ConsoleInit(&port, rtc);
+    TEST_ASSERT_NULL(strstr(Command(""), "ok"));
+    TEST_ASSERT_FALSE(ClockGetTime(rtc, &(clock_time_t){0}));
+}
+
+//! El estado reúne los datos de cada módulo
+void test_stats(void) {
+    static monitor_report_t report = {.task_count = 1, .tasks = {{.name = "Tarea", .cpu_permille = 125}}};
+    static trace_log_t log = {.head = 42};
+
+    MonitorGetReport_IgnoreAndReturn(&report);
+    ServiceWorstCaseUs_IgnoreAndReturn(12);
+    ServiceOverruns_IgnoreAndReturn(3);
+    PowerHeadroom_IgnoreAndReturn(500);
+    PowerGetStats_Ignore();
+    TraceGetLog_IgnoreAndReturn(&log);
+    SyncGetStats_Ignore();
+
+    Command("estado\r");
+    TEST_ASSERT_NOT_NULL(strstr(output, "Tarea cpu 12.5%"));
+    TEST_ASSERT_NOT_NULL(strstr(output, "servicio peor caso 12 us excesos 3"));
+    TEST_ASSERT_NOT_NULL(strstr(output, "traza 42 eventos"));
+}
+
+/* === End of documentation ======================================================================================== */
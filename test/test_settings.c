@@ -0,0 +1,270 @@
+/*********************************************************************************************************************
+Copyright (c) 2025, Martín Fernando Gareca del autor <mfgareca36@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*********************************************************************************************************************/
+
+
+
+/** @file test_settings.c
+ ** @brief Pruebas del registro circular de configuración contra una memoria simulada con cortes de alimentación
+ **/
+
+/* === Headers files inclusions ==================================================================================== */
+
+#include "unity.h"
+#include "settings.h"
+#include "eeprom_fake.h"
+#include <stddef.h>
+#include <string.h>
+
+/* === Macros definitions ========================================================================================== */
+
+#define SLOTS (EEPROM_FAKE_SIZE / SETTINGS_SLOT_SIZE)
+
+#define RECORD_HEADER_SIZE 12 // Número de orden, versión, tamaño y CRC de cada registro
+
+/* === Private data type declarations ============================================================================== */
+
+/* === Private variable definitions ================================================================================ */
+
+static settings_storage_t storage;
+
+static uint8_t snapshot[EEPROM_FAKE_SIZE]; /**< Contenido de la memoria antes de la escritura interrumpida */
+
+static uint8_t written[EEPROM_FAKE_SIZE]; /**< Contenido de la memoria con la escritura completa */
+
+/* === Private function declarations =============================================================================== */
+
+/* === Private function definitions ================================================================================ */
+
+//! Configuración distinta para cada número, para reconocer qué registro se recuperó
+static settings_t Settings(uint8_t number) {
+    settings_t settings;
+
+    memset(&settings, 0, sizeof(settings));
+    settings.time.bcd[0] = number % 10;
+    settings.time.bcd[1] = number / 10 % 6;
+    settings.time_valid = true;
+    settings.brightness = number;
+    return settings;
+}
+
+//! Simula un reinicio y verifica que se recupere la configuración esperada
+static void AssertRecovered(const settings_t * expected) {
+    settings_t loaded;
+
+    TEST_ASSERT_TRUE(SettingsInit(storage));
+    TEST_ASSERT_TRUE(SettingsLoad(&loaded));
+    TEST_ASSERT_EQUAL_MEMORY(expected, &loaded, sizeof(settings_t));
+}
+
+//! Corta la alimentación después de cada byte de la escritura de next y verifica que se recupere previous
+static void AssertEveryCutRecovers(const settings_t * previous, const settings_t * next) {
+    uint32_t size;
+    uint32_t cut;
+
+    memcpy(snapshot, eeprom_fake, sizeof(snapshot));
+    TEST_ASSERT_EQUAL(0, SettingsSave(next));
+    memcpy(written, eeprom_fake, sizeof(written));
+    size = EepromFakeLastWriteSize();
+    TEST_ASSERT_GREATER_THAN(0, size);
+
+    for (cut = 0; cut < size; cut++) {
+        memcpy(eeprom_fake, snapshot, sizeof(snapshot));
+        TEST_ASSERT_TRUE(SettingsInit(storage));
+        EepromFakeCutAfter(cut);
+        TEST_ASSERT_EQUAL(-1, SettingsSave(next));
+        EepromFakeCutAfter(EEPROM_FAKE_NO_CUT);
+        if (memcmp(eeprom_fake, written, sizeof(written)) == 0) {
+            AssertRecovered(next); /**< Los bytes que faltaban ya tenían su valor final, el registro está completo */
+        } else {
+            AssertRecovered(previous);
+        }
+    }
+}
+
+//! CRC-32 reflejado, el mismo que protege cada registro
+static uint32_t Crc(uint32_t crc, const uint8_t * data, uint32_t size) {
+    for (uint32_t index = 0; index < size; index++) {
+        crc ^= data[index];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320 : 0);
+        }
+    }
+    return crc;
+}
+
+//! Escribe en una posición un registro armado a mano, como lo habría guardado otra versión del firmware
+static void WriteRecord(uint32_t slot, uint32_t sequence, uint16_t version, const void * data, uint16_t size) {
+    uint8_t * record = &eeprom_fake[slot * SETTINGS_SLOT_SIZE];
+    uint32_t crc;
+
+    memcpy(&record[0], &sequence, sizeof(sequence));
+    memcpy(&record[4], &version, sizeof(version));
+    memcpy(&record[6], &size, sizeof(size));
+    memcpy(&record[RECORD_HEADER_SIZE], data, size);
+    crc = ~Crc(Crc(0xFFFFFFFF, &record[0], 8), &record[RECORD_HEADER_SIZE], size);
+    memcpy(&record[8], &crc, sizeof(crc));
+}
+
+/* === Public function definitions ================================================================================= */
+
+void setUp(void) {
+    storage = EepromFakeCreate();
+}
+
+void tearDown(void) {
+}
+
+//! Una memoria borrada no tiene configuración
+void test_erased_memory_has_no_settings(void) {
+    settings_t loaded;
+
+    TEST_ASSERT_FALSE(SettingsInit(storage));
+    TEST_ASSERT_FALSE(SettingsLoad(&loaded));
+}
+
+//! Una memoria inválida se rechaza y no permite guardar
+void test_invalid_storage_is_rejected(void) {
+    settings_t settings = Settings(1);
+
+    TEST_ASSERT_FALSE(SettingsInit(NULL));
+    TEST_ASSERT_EQUAL(-1, SettingsSave(&settings));
+}
+
+//! La configuración guardada se recupera después de un reinicio
+void test_saved_settings_survive_restart(void) {
+    settings_t settings = Settings(1);
+
+    SettingsInit(storage);
+    TEST_ASSERT_EQUAL(0, SettingsSave(&settings));
+    AssertRecovered(&settings);
+}
+
+//! Guardar la misma configuración no escribe la memoria
+void test_unchanged_settings_are_not_written(void) {
+    settings_t settings = Settings(1);
+
+    SettingsInit(storage);
+    SettingsSave(&settings);
+    memcpy(snapshot, eeprom_fake, sizeof(snapshot));
+    TEST_ASSERT_EQUAL(0, SettingsSave(&settings));
+    TEST_ASSERT_EQUAL_MEMORY(snapshot, eeprom_fake, sizeof(snapshot));
+}
+
+//! Un corte en cualquier byte de la escritura conserva el último registro bueno
+void test_power_cut_at_any_byte_recovers_last_good_record(void) {
+    settings_t previous = Settings(1);
+    settings_t next = Settings(2);
+
+    SettingsInit(storage);
+    SettingsSave(&previous);
+    AssertEveryCutRecovers(&previous, &next);
+}
+
+//! Un corte durante la primera escritura deja la memoria sin configuración
+void test_power_cut_on_first_write_leaves_no_settings(void) {
+    settings_t settings = Settings(1);
+    settings_t loaded;
+    uint32_t cut;
+
+    for (cut = 0; cut < SETTINGS_SLOT_SIZE; cut++) {
+        storage = EepromFakeCreate();
+        SettingsInit(storage);
+        EepromFakeCutAfter(cut);
+        if (SettingsSave(&settings) == 0) {
+            break; /**< El registro ya entró completo */
+        }
+        EepromFakeCutAfter(EEPROM_FAKE_NO_CUT);
+        TEST_ASSERT_FALSE(SettingsInit(storage));
+        TEST_ASSERT_FALSE(SettingsLoad(&loaded));
+    }
+    TEST_ASSERT_EQUAL(EepromFakeLastWriteSize(), cut);
+}
+
+//! Después de un corte se puede seguir guardando y el registro nuevo es el recuperado
+void test_save_after_power_cut(void) {
+    settings_t previous = Settings(1);
+    settings_t lost = Settings(2);
+    settings_t next = Settings(3);
+
+    SettingsInit(storage);
+    SettingsSave(&previous);
+    EepromFakeCutAfter(SETTINGS_SLOT_SIZE / 2);
+    SettingsSave(&lost);
+    EepromFakeCutAfter(EEPROM_FAKE_NO_CUT);
+
+    AssertRecovered(&previous);
+    TEST_ASSERT_EQUAL(0, SettingsSave(&next));
+    AssertRecovered(&next);
+}
+
+//! Los registros dan la vuelta a la memoria y se recupera siempre el más reciente
+void test_records_wrap_around(void) {
+    settings_t settings;
+    uint8_t number;
+
+    SettingsInit(storage);
+    for (number = 1; number <= 3 * SLOTS + 1; number++) {
+        settings = Settings(number);
+        TEST_ASSERT_EQUAL(0, SettingsSave(&settings));
+        AssertRecovered(&settings);
+    }
+}
+
+//! Un corte al sobrescribir el registro más antiguo, después de dar la vuelta, conserva el último bueno
+void test_power_cut_after_wrap_recovers_last_good_record(void) {
+    settings_t previous;
+    settings_t next = Settings(SLOTS + 1);
+    uint8_t number;
+
+    SettingsInit(storage);
+    for (number = 1; number <= SLOTS; number++) {
+        previous = Settings(number);
+        SettingsSave(&previous);
+    }
+    AssertEveryCutRecovers(&previous, &next);
+}
+
+//! Un registro de una versión anterior, más corto, se recupera con los campos que no tenía en cero
+void test_older_version_record_is_migrated(void) {
+    settings_t settings = Settings(7);
+    settings_t expected;
+    uint16_t size = offsetof(settings_t, brightness);
+
+    memset(&expected, 0, sizeof(expected));
+    memcpy(&expected, &settings, size);
+    WriteRecord(0, 5, SETTINGS_VERSION - 1, &settings, size);
+    AssertRecovered(&expected);
+
+    // El próximo guardado ya usa el formato actual y continúa la secuencia
+    TEST_ASSERT_EQUAL(0, SettingsSave(&settings));
+    AssertRecovered(&settings);
+}
+
+//! Un registro de una versión posterior no se interpreta y se recupera el último de una versión conocida
+void test_newer_version_record_is_ignored(void) {
+    settings_t settings = Settings(1);
+    settings_t newer = Settings(2);
+
+    SettingsInit(storage);
+    SettingsSave(&settings);
+    WriteRecord(1, 100, SETTINGS_VERSION + 1, &newer, sizeof(newer));
+    AssertRecovered(&settings);
+}
+
+/* === End of documentation ======================================================================================== */
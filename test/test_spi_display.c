@@ -0,0 +1,201 @@
+/*********************************************************************************************************************
+Copyright (c) 2025, Martín Fernando Gareca del autor <mfgareca36@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*********************************************************************************************************************/
+
+
+/** @file test_spi_display.c
+ ** @brief Pruebas del driver de pantalla con registros de desplazamiento contra un puerto serie simulado
+ **/
+
+/* === Headers files inclusions ==================================================================================== */
+
+#include "unity.h"
+#include "spi_display.h"
+#include "screen.h"
+#include "mock_trace.h"
+#include <string.h>
+
+/* === Macros definitions ========================================================================================== */
+
+#define DIGITS 4
+
+/* === Private data type declarations ============================================================================== */
+
+/* === Private variable definitions ================================================================================ */
+
+static uint8_t sent[SPI_DISPLAY_MAX_DIGITS]; /**< Última trama recibida por el puerto simulado */
+
+static uint8_t sent_size; /**< Bytes de la última trama */
+
+static uint8_t sends; /**< Tramas recibidas desde setUp */
+
+static screen_driver_t driver;
+
+/* === Private function declarations =============================================================================== */
+
+/* === Private function definitions ================================================================================ */
+
+//! Puerto serie simulado, guarda la trama como la vería la cadena de registros
+static void SpiSink(const uint8_t * frame, uint8_t size) {
+    memcpy(sent, frame, size);
+    sent_size = size;
+    sends++;
+}
+
+//! Completa un barrido de la pantalla, un refresco por dígito
+static void RefreshSweep(screen_t screen) {
+    for (uint8_t i = 0; i < DIGITS; i++) {
+        ScreenRefresh(screen);
+    }
+}
+
+/* === Public function definitions ================================================================================= */
+
+void setUp(void) {
+    TraceRecord_Ignore();
+    driver = SpiDisplayCreate(DIGITS, SpiSink);
+    sends = 0;
+}
+
+void tearDown(void) {
+}
+
+//! Los parámetros inválidos no crean el driver
+void test_create_rejects_invalid_parameters(void) {
+    TEST_ASSERT_NULL(SpiDisplayCreate(0, SpiSink));
+    TEST_ASSERT_NULL(SpiDisplayCreate(SPI_DISPLAY_MAX_DIGITS + 1, SpiSink));
+    TEST_ASSERT_NULL(SpiDisplayCreate(DIGITS, NULL));
+}
+
+//! Al crearlo se envía una trama que apaga toda la cadena
+void test_create_clears_the_chain(void) {
+    static const uint8_t blank[DIGITS] = {0};
+
+    sends = 0;
+    driver = SpiDisplayCreate(DIGITS, SpiSink);
+    TEST_ASSERT_NOT_NULL(driver);
+    TEST_ASSERT_EQUAL(1, sends);
+    TEST_ASSERT_EQUAL(DIGITS, sent_size);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(blank, sent, DIGITS);
+}
+
+//! Los dígitos se acumulan y la trama se envía una sola vez al completar el barrido
+void test_one_transfer_per_sweep(void) {
+    driver->SegmentsUpdate(0x11);
+    driver->DigitTurnOn(0);
+    driver->SegmentsUpdate(0x22);
+    driver->DigitTurnOn(1);
+    driver->SegmentsUpdate(0x33);
+    driver->DigitTurnOn(2);
+    TEST_ASSERT_EQUAL(0, sends);
+
+    driver->SegmentsUpdate(0x44);
+    driver->DigitTurnOn(3);
+    TEST_ASSERT_EQUAL(1, sends);
+}
+
+//! El primer byte desplazado termina en el último registro, por lo que la trama va del último dígito al primero
+void test_frame_is_sent_last_digit_first(void) {
+    static const uint8_t expected[DIGITS] = {0x44, 0x33, 0x22, 0x11};
+
+    for (uint8_t digit = 0; digit < DIGITS; digit++) {
+        driver->SegmentsUpdate(0x11 * (digit + 1));
+        driver->DigitTurnOn(digit);
+    }
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, sent, DIGITS);
+}
+
+//! Un barrido sin cambios no ocupa el puerto
+void test_unchanged_sweep_is_not_sent(void) {
+    screen_t screen = ScreenCreate(DIGITS, driver);
+    uint8_t value[] = {1, 2, 3, 4};
+    uint8_t settled;
+
+    ScreenWriteBCD(screen, value, sizeof(value));
+    RefreshSweep(screen);
+    RefreshSweep(screen); /**< El barrido comienza en el segundo dígito, con dos se completa la trama */
+    settled = sends;
+    TEST_ASSERT_LESS_OR_EQUAL(2, settled);
+
+    RefreshSweep(screen);
+    RefreshSweep(screen);
+    TEST_ASSERT_EQUAL(settled, sends);
+}
+
+//! Un cambio en un solo dígito envía la trama completa una sola vez
+void test_changed_digit_sends_whole_frame(void) {
+    screen_t screen = ScreenCreate(DIGITS, driver);
+    uint8_t value[] = {1, 2, 3, 4};
+    uint8_t settled;
+
+    ScreenWriteBCD(screen, value, sizeof(value));
+    RefreshSweep(screen);
+    RefreshSweep(screen);
+    TEST_ASSERT_EQUAL(SEGMENT_B | SEGMENT_C, sent[0]);
+    TEST_ASSERT_EQUAL(SEGMENT_B | SEGMENT_C | SEGMENT_F | SEGMENT_G, sent[3]);
+    settled = sends;
+
+    value[0] = 7;
+    ScreenWriteBCD(screen, value, sizeof(value));
+    RefreshSweep(screen);
+    RefreshSweep(screen);
+    TEST_ASSERT_EQUAL(settled + 1, sends);
+    TEST_ASSERT_EQUAL(DIGITS, sent_size);
+    TEST_ASSERT_EQUAL(SEGMENT_A | SEGMENT_B | SEGMENT_C, sent[0]);
+    TEST_ASSERT_EQUAL(SEGMENT_B | SEGMENT_C | SEGMENT_F | SEGMENT_G, sent[3]);
+}
+
+//! El driver no controla el brillo: la pantalla rechaza cambiarlo y la pantalla apagada no genera tramas
+void test_brightness_is_not_supported(void) {
+    screen_t screen = ScreenCreate(DIGITS, driver);
+
+    TEST_ASSERT_EQUAL(-1, ScreenSetBrightness(screen, 3));
+    RefreshSweep(screen);
+    TEST_ASSERT_EQUAL(0, sends);
+}
+
+//! Los caracteres fuera de la tabla ASCII se muestran apagados y no como otra letra
+void test_text_outside_ascii_is_blank(void) {
+    screen_t screen = ScreenCreate(DIGITS, driver);
+
+    ScreenWriteText(screen, "1\xB1\xC1\xF1");
+    RefreshSweep(screen);
+    RefreshSweep(screen);
+    TEST_ASSERT_EQUAL(0, sent[0]);
+    TEST_ASSERT_EQUAL(0, sent[1]);
+    TEST_ASSERT_EQUAL(0, sent[2]);
+    TEST_ASSERT_EQUAL(SEGMENT_B | SEGMENT_C, sent[3]);
+}
+
+//! Una pantalla que ya forma parte de la cadena no se puede volver a encadenar, así la cadena nunca se cierra
+void test_chain_rejects_screen_already_chained(void) {
+    screen_t first = ScreenCreate(DIGITS, driver);
+    screen_t second = ScreenCreate(DIGITS, driver);
+
+    TEST_ASSERT_EQUAL(-1, ScreenChain(first, first));
+    TEST_ASSERT_EQUAL(0, ScreenChain(first, second));
+    TEST_ASSERT_EQUAL(-1, ScreenChain(first, second));
+    TEST_ASSERT_EQUAL(-1, ScreenChain(second, second));
+    TEST_ASSERT_EQUAL(-1, ScreenChain(second, first));
+
+    sends = 0;
+    ScreenRefresh(first);
+    TEST_ASSERT_EQUAL(0, sends);
+}
+
+/* === End of documentation ======================================================================================== */
@@ -0,0 +1,345 @@
+/*********************************************************************************************************************
+Copyright (c) 2025, Martín Fernando Gareca del autor <mfgareca36@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*********************************************************************************************************************/
+
+
+
+/** @file test_sync.c
+ ** @brief Pruebas de la sincronización con un receptor GPS simulado: sentencias RMC por el puerto y pulso por segundo
+ **
+ ** La simulación avanza de a un milisegundo: cada paso es un tick del reloj y del contador del monitor, y cada
+ ** SYNC_PERIOD_MS pasos se atiende la sincronización como lo hace su tarea.
+ **/
+
+/* === Headers files inclusions ==================================================================================== */
+
+#include "unity.h"
+#include "sync.h"
+#include "clock.h"
+#include "bcd.h"
+#include "freertos_fake.h"
+#include "mock_monitor.h"
+#include <stdio.h>
+#include <string.h>
+
+/* === Macros definitions ========================================================================================== */
+
+#define COUNTS_PER_MS (MONITOR_TIMER_HZ / 1000)
+
+#define SENTENCE_DELAY_MS 350 // Demora del receptor entre el pulso y la sentencia que nombra ese segundo
+
+#define DRIFT_SECOND_MS 1005 // Ticks entre pulsos de un reloj local que adelanta 5 ms por segundo
+
+/* === Private data type declarations ============================================================================== */
+
+/* === Private function declarations =============================================================================== */
+
+static uint16_t RxPosition(void);
+
+/* === Private variable definitions ================================================================================ */
+
+static uint8_t rx[SYNC_RX_SIZE];
+
+static uint16_t rx_position; /**< Como el DMA, de 0 a SYNC_RX_SIZE inclusive antes de recargar el descriptor */
+
+static uint32_t monitor_count; /**< Contador simulado del monitor */
+
+static uint32_t elapsed_ms; /**< Tiempo simulado desde el comienzo de la prueba */
+
+static clock_t rtc;
+
+static const struct sync_port_s port = {
+    .rx_buffer = rx,
+    .RxPosition = RxPosition,
+};
+
+/* === Private function definitions ================================================================================ */
+
+static uint16_t RxPosition(void) {
+    return rx_position;
+}
+
+static uint32_t FakeMonitorCount(int calls) {
+    (void)calls;
+    return monitor_count;
+}
+
+//! Recibe bytes como los escribiría el DMA, recargando el descriptor al llegar al final del buffer
+static void ReceiveBytes(const uint8_t * data, size_t size) {
+    while (size-- > 0) {
+        if (rx_position == SYNC_RX_SIZE) {
+            rx_position = 0;
+        }
+        rx[rx_position++] = *data++;
+    }
+}
+
+static void Receive(const char * text) {
+    ReceiveBytes((const uint8_t *)text, strlen(text));
+}
+
+//! Avanza el tiempo simulado, con la tarea de sincronización en su período
+static void Advance(uint32_t milliseconds) {
+    while (milliseconds-- > 0) {
+        ClockNewTick(rtc);
+        monitor_count += COUNTS_PER_MS;
+        elapsed_ms++;
+        if ((elapsed_ms % SYNC_PERIOD_MS) == 0) {
+            SyncPoll();
+        }
+    }
+}
+
+//! Flanco del pulso por segundo, registrado desde la interrupción
+static void Pulse(void) {
+    SyncPulse();
+}
+
+//! Envía una sentencia NMEA completa a partir de los campos, agregando la suma de verificación
+static void SendNmea(const char * fields) {
+    char sentence[96];
+    uint8_t checksum = 0;
+
+    for (const char * character = fields; *character != '\0'; character++) {
+        checksum ^= (uint8_t)*character;
+    }
+    snprintf(sentence, sizeof(sentence), "$%s*%02X\r\n", fields, checksum);
+    Receive(sentence);
+}
+
+//! Envía la sentencia RMC de un receptor con referencia válida
+static void SendRmc(const char * utc_time, const char * utc_date) {
+    char fields[80];
+
+    snprintf(fields, sizeof(fields), "GPRMC,%s,A,3436.0000,S,05822.0000,W,0.0,0.0,%s,,,A", utc_time, utc_date);
+    SendNmea(fields);
+}
+
+//! Un segundo completo del receptor: pulso, sentencias de posición y RMC con la hora de ese pulso
+static void GpsSecond(const char * utc_time, const char * utc_date) {
+    Pulse();
+    Advance(SENTENCE_DELAY_MS);
+    SendNmea("GPGGA,000000.00,3436.0000,S,05822.0000,W,1,08,0.9,25.0,M,14.0,M,,");
+    SendRmc(utc_time, utc_date);
+    Advance(1000 - SENTENCE_DELAY_MS);
+}
+
+static void AssertTime(uint8_t hours, uint8_t minutes, uint8_t seconds) {
+    clock_time_t time;
+
+    TEST_ASSERT_TRUE(ClockGetTime(rtc, &time));
+    TEST_ASSERT_EQUAL_UINT32(hours * 3600 + minutes * 60 + seconds, BcdTimeToSeconds(&time));
+}
+
+static void AssertDate(uint16_t year, uint8_t month, uint8_t day) {
+    clock_date_t date;
+
+    TEST_ASSERT_TRUE(ClockGetDate(rtc, &date));
+    TEST_ASSERT_EQUAL_UINT16(year, date.year);
+    TEST_ASSERT_EQUAL_UINT8(month, date.month);
+    TEST_ASSERT_EQUAL_UINT8(day, date.day);
+}
+
+/* === Public function definitions ================================================================================= */
+
+void setUp(void) {
+    memset(rx, 0, sizeof(rx));
+    rx_position = 0;
+    monitor_count = 0;
+    elapsed_ms = 0;
+    FreeRTOSFakeReset();
+    MonitorTimerGetCount_StubWithCallback(FakeMonitorCount);
+    rtc = ClockCreate();
+    TEST_ASSERT_TRUE(SyncSetUtcOffset(0));
+    SyncInit(&port, rtc);
+}
+
+void tearDown(void) {
+    TEST_ASSERT_EQUAL_UINT32(0, FreeRTOSFakeCriticalNesting());
+}
+
+//! Sin diferencia horaria la sentencia RMC fija la hora UTC y la fecha
+void test_rmc_without_offset_sets_utc(void) {
+    SendRmc("123456.00", "150324");
+    Advance(SYNC_PERIOD_MS);
+    AssertTime(12, 34, 56);
+    AssertDate(2024, 3, 15);
+}
+
+//! La hora UTC se pasa a la local con la diferencia configurada
+void test_rmc_is_converted_to_local_time(void) {
+    TEST_ASSERT_TRUE(SyncSetUtcOffset(-3 * 60));
+    SendRmc("153000.00", "150324");
+    Advance(SYNC_PERIOD_MS);
+    AssertTime(12, 30, 0);
+    AssertDate(2024, 3, 15);
+}
+
+//! Con una diferencia negativa la hora local puede ser del día anterior, incluso el 29 de febrero
+void test_negative_offset_goes_back_a_day(void) {
+    TEST_ASSERT_TRUE(SyncSetUtcOffset(-3 * 60));
+    SendRmc("010000.00", "010324");
+    Advance(SYNC_PERIOD_MS);
+    AssertTime(22, 0, 0);
+    AssertDate(2024, 2, 29);
+}
+
+//! Con una diferencia negativa el 1 de enero UTC todavía es el año anterior
+void test_negative_offset_goes_back_a_year(void) {
+    TEST_ASSERT_TRUE(SyncSetUtcOffset(-(5 * 60 + 30)));
+    SendRmc("020000.00", "010125");
+    Advance(SYNC_PERIOD_MS);
+    AssertTime(20, 30, 0);
+    AssertDate(2024, 12, 31);
+}
+
+//! Con una diferencia positiva la hora local puede ser del día siguiente, incluso del año siguiente
+void test_positive_offset_goes_forward_a_year(void) {
+    TEST_ASSERT_TRUE(SyncSetUtcOffset(14 * 60));
+    SendRmc("220000.00", "311223");
+    Advance(SYNC_PERIOD_MS);
+    AssertTime(12, 0, 0);
+    AssertDate(2024, 1, 1);
+}
+
+//! Las diferencias fuera de los husos existentes no se aceptan
+void test_offset_out_of_range_is_rejected(void) {
+    TEST_ASSERT_TRUE(SyncSetUtcOffset(SYNC_UTC_OFFSET_MAX));
+    TEST_ASSERT_FALSE(SyncSetUtcOffset(SYNC_UTC_OFFSET_MAX + 1));
+    TEST_ASSERT_FALSE(SyncSetUtcOffset(SYNC_UTC_OFFSET_MIN - 1));
+    TEST_ASSERT_EQUAL_INT16(SYNC_UTC_OFFSET_MAX, SyncGetUtcOffset());
+}
+
+//! Una fecha inválida no se vuelve válida al cambiar de día
+void test_invalid_date_is_not_rolled_over(void) {
+    sync_stats_t stats;
+
+    TEST_ASSERT_TRUE(SyncSetUtcOffset(3 * 60));
+    SendRmc("230000.00", "321223");
+    Advance(SYNC_PERIOD_MS);
+    SyncGetStats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.messages);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.rejected);
+    TEST_ASSERT_FALSE(ClockGetTime(rtc, &(clock_time_t){0}));
+}
+
+//! Una sentencia con la suma de verificación errónea se descarta
+void test_bad_checksum_is_rejected(void) {
+    sync_stats_t stats;
+
+    Receive("$GPRMC,123456.00,A,3436.0000,S,05822.0000,W,0.0,0.0,150324,,,A*00\r\n");
+    Advance(SYNC_PERIOD_MS);
+    SyncGetStats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.rejected);
+    TEST_ASSERT_FALSE(ClockGetTime(rtc, &(clock_time_t){0}));
+}
+
+//! Sin referencia válida el receptor envía el estado V y el reloj no cambia
+void test_receiver_without_fix_is_ignored(void) {
+    SendNmea("GPRMC,123456.00,V,,,,,,,150324,,,N");
+    Advance(SYNC_PERIOD_MS);
+    TEST_ASSERT_FALSE(ClockGetTime(rtc, &(clock_time_t){0}));
+}
+
+//! Con pulso, la sentencia nombra el segundo que comenzó en el pulso y la fase queda alineada a él
+void test_sentence_after_pulse_is_phase_locked(void) {
+    sync_stats_t stats;
+
+    TEST_ASSERT_TRUE(SyncSetUtcOffset(-3 * 60));
+    GpsSecond("235958.00", "311224");
+    Pulse();
+    Advance(SYNC_PERIOD_MS);
+    SyncGetStats(&stats);
+    TEST_ASSERT_TRUE(stats.pulse_locked);
+    AssertTime(20, 59, 59); /**< El segundo siguiente comenzó con el pulso */
+    TEST_ASSERT_INT_WITHIN(1, SYNC_PERIOD_MS, ClockGetMilliseconds(rtc));
+    AssertDate(2024, 12, 31);
+}
+
+//! Varios segundos seguidos de un receptor con pulso mantienen el reloj en fase, pasando la medianoche local
+void test_receiver_keeps_the_clock_in_phase(void) {
+    static const char * const TIMES[] = {"025958.00", "025959.00", "030000.00", "030001.00"};
+    sync_stats_t start;
+    sync_stats_t stats;
+
+    SyncPoll();
+    SyncGetStats(&start); /**< Los pulsos se cuentan desde el arranque */
+    TEST_ASSERT_TRUE(SyncSetUtcOffset(-3 * 60));
+    for (uint8_t second = 0; second < sizeof(TIMES) / sizeof(TIMES[0]); second++) {
+        GpsSecond(TIMES[second], "010125");
+    }
+    Pulse();
+    Advance(SYNC_PERIOD_MS);
+    AssertTime(0, 0, 2);
+    AssertDate(2025, 1, 1);
+    TEST_ASSERT_INT_WITHIN(1, SYNC_PERIOD_MS, ClockGetMilliseconds(rtc));
+    SyncGetStats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(4, stats.messages);
+    TEST_ASSERT_EQUAL_UINT32(5, stats.pulses - start.pulses);
+    TEST_ASSERT_TRUE(stats.pulse_locked);
+    TEST_ASSERT_INT_WITHIN(1, 0, stats.offset_ms);
+}
+
+//! Con un reloj local que adelanta, cada pulso vuelve a llevar la fase al comienzo del segundo sin perder la hora
+void test_fast_local_clock_is_realigned_on_every_pulse(void) {
+    char utc_time[16];
+    sync_stats_t stats;
+
+    for (uint8_t second = 0; second <= 20; second++) {
+        Pulse();
+        Advance(SYNC_PERIOD_MS);
+        if (second > 0) { /**< El primer segundo solo fija la hora */
+            TEST_ASSERT_INT_WITHIN(1, SYNC_PERIOD_MS, ClockGetMilliseconds(rtc));
+            AssertTime(12, 0, second);
+            SyncGetStats(&stats);
+            TEST_ASSERT_TRUE(stats.pulse_locked);
+            TEST_ASSERT_INT_WITHIN(1, -(DRIFT_SECOND_MS - 1000), stats.offset_ms); /**< Se corrige lo adelantado */
+        }
+
+        Advance(SENTENCE_DELAY_MS - SYNC_PERIOD_MS);
+        snprintf(utc_time, sizeof(utc_time), "1200%02u.00", second);
+        SendRmc(utc_time, "150324");
+        Advance(DRIFT_SECOND_MS - SENTENCE_DELAY_MS);
+    }
+}
+
+//! Una sentencia que cruza el final del buffer circular se interpreta completa
+void test_sentence_across_the_end_of_the_ring(void) {
+    rx_position = SYNC_RX_SIZE - 20;
+    SyncInit(&port, rtc);
+    SendRmc("101112.00", "150324");
+    Advance(SYNC_PERIOD_MS);
+    AssertTime(10, 11, 12);
+}
+
+//! La trama binaria trae la hora local y no se corrige
+void test_binary_frame_is_local_time(void) {
+    uint8_t frame[] = {SYNC_FRAME_START, SYNC_FRAME_SYNC, 0xE8, 0x07, 3, 15, 8, 9, 10, 0, 0, 0};
+
+    for (uint8_t index = 2; index < sizeof(frame) - 1; index++) {
+        frame[sizeof(frame) - 1] ^= frame[index]; /**< O exclusivo de los nueve bytes de datos */
+    }
+
+    TEST_ASSERT_TRUE(SyncSetUtcOffset(-3 * 60));
+    ReceiveBytes(frame, sizeof(frame));
+    Advance(SYNC_PERIOD_MS);
+    AssertTime(8, 9, 10);
+    AssertDate(2024, 3, 15);
+}
+
+/* === End of documentation ======================================================================================== */
@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+# Copyright (c) 2025, Martín Fernando Gareca del autor <mfgareca36@gmail.com>
+# SPDX-License-Identifier: MIT
+
+"""Decodifica un volcado del registro de traza (src/trace.c) y lo muestra como una línea de tiempo.
+
+El volcado se obtiene con el depurador detenido, por ejemplo desde gdb:
+
+    dump binary value trace.bin trace_log
+
+Los tiempos se calculan desde el registro más nuevo hacia atrás: el encabezado guarda la frecuencia del núcleo al
+momento del volcado y cada evento de reloj indica la frecuencia anterior, así los ciclos de cada tramo se convierten
+con la frecuencia que tenía el núcleo aunque el buffer ya haya pisado el arranque. El contador de ciclos da la vuelta
+en unos 21 segundos a 204 MHz, entre dos registros consecutivos no puede pasar más que eso.
+"""
+
+import argparse
+import struct
+import sys
+
+TRACE_MAGIC = 0x45435254
+TRACE_VERSION = 1
+
+HEADER = struct.Struct("<IHHIII")
+RECORD = struct.Struct("<IBBH")
+
+EVENTS = {
+    1: "CLOCK",
+    2: "TASK",
+    3: "GROUP_SET",
+    4: "GROUP_BLOCK",
+    5: "GROUP_WAKE",
+    6: "KEY",
+    7: "STATE",
+    8: "SCREEN_BCD",
+    9: "SCREEN_TEXT",
+    10: "SERVICE",
+}
+
+# Mismo orden que clock_state_t en src/timeMEF.c
+STATES = [
+    "SHOW_TIME",
+    "ADJUST_TIME_MINUTES",
+    "ADJUST_TIME_HOURS",
+    "ADJUST_DATE_DAY",
+    "ADJUST_DATE_MONTH",
+    "ADJUST_DATE_YEAR",
+    "ADJUST_ALARM_MINUTES",
+    "ADJUST_ALARM_HOURS",
+    "ADJUST_ALARM_DAYS",
+    "CONTROL_ALARM",
+    "STOPWATCH",
+    "COUNTDOWN",
+]
+
+# Mismos bits que TECLA_* y EVENTO_* en src/main.c
+BITS = ["ACCEPT", "CANCEL", "INCREMENT", "DECREMENT", "SET_TIME", "SET_ALARM", "TIMER", "TIMEOUT"]
+
+
+def bit_names(value):
+    names = [name for index, name in enumerate(BITS) if value & (1 << index)]
+    return "|".join(names) if names else "0x{:04x}".format(value)
+
+
+def state_name(value):
+    return STATES[value] if value < len(STATES) else str(value)
+
+
+def describe(event, arg8, arg16, tasks):
+    if event == 1:
+        return "{} MHz -> {} MHz".format(arg8, arg16)
+    if event == 2:
+        return tasks.get(arg16, "#{}".format(arg16))
+    if event == 3:
+        return bit_names(arg16) + (" (ISR)" if arg8 else "")
+    if event == 4:
+        return bit_names(arg16)
+    if event == 5:
+        return bit_names(arg16) + (" timeout" if arg8 else "")
+    if event == 6:
+        return bit_names(arg16) + (" long " + bit_names(arg8) if arg8 else "")
+    if event == 7:
+        return "{} -> {}".format(state_name(arg8), state_name(arg16))
+    if event == 8:
+        # El primer valor escrito es el dígito de la derecha, se muestran en el orden de la pantalla
+        return "".join(str((arg16 >> (4 * i)) & 0x0F) for i in reversed(range(min(arg8, 4))))
+    if event == 9:
+        text = bytes([arg16 & 0xFF, arg16 >> 8][: min(arg8, 2)])
+        return repr(text.decode("latin-1"))
+    if event == 10:
+        return "{} us".format(arg16) + (" fuera de presupuesto" if arg8 else "")
+    return "arg8={} arg16={}".format(arg8, arg16)
+
+
+def load(data):
+    magic, version, size, head, mask, core_mhz = struct.unpack_from(HEADER.format, data)
+    if magic != TRACE_MAGIC:
+        raise ValueError("no es un volcado del registro de traza")
+    if version != TRACE_VERSION:
+        raise ValueError("versión de formato {} no soportada".format(version))
+    if len(data) < HEADER.size + size * RECORD.size:
+        raise ValueError("volcado incompleto")
+
+    count = min(head, size)
+    records = []
+    for sequence in range(head - count, head):
+        offset = HEADER.size + (sequence % size) * RECORD.size
+        records.append((sequence,) + RECORD.unpack_from(data, offset))
+    return records, core_mhz, mask
+
+
+def timeline(records, core_mhz):
+    """Devuelve los registros con su tiempo en microsegundos, 0 para el más viejo."""
+    times = [0.0] * len(records)
+    mhz = core_mhz
+    for index in range(len(records) - 1, 0, -1):
+        cycles, event, arg8 = records[index][1], records[index][2], records[index][3]
+        if event == 1 and arg8 != 0:
+            mhz = arg8  # Antes de este cambio el núcleo funcionaba a la frecuencia anterior
+        delta = (cycles - records[index - 1][1]) & 0xFFFFFFFF
+        times[index - 1] = times[index] - delta / max(mhz, 1)
+    start = times[0] if times else 0.0
+    return [time - start for time in times]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("dump", help="archivo binario con el contenido de trace_log")
+    parser.add_argument("--task", action="append", default=[], metavar="N=NOMBRE",
+                        help="nombre de una tarea por su número, se puede repetir")
+    parser.add_argument("--slow", type=float, default=0.0, metavar="US",
+                        help="marcar los eventos que llegan más de US microsegundos después del anterior")
+    options = parser.parse_args()
+
+    tasks = {}
+    for item in options.task:
+        number, _, name = item.partition("=")
+        tasks[int(number)] = name
+
+    with open(options.dump, "rb") as dump:
+        records, core_mhz, mask = load(dump.read())
+    if not records:
+        print("sin eventos registrados")
+        return 0
+
+    times = timeline(records, core_mhz)
+    print("{} eventos, núcleo a {} MHz, máscara 0x{:04x}".format(len(records), core_mhz, mask))
+    previous = 0.0
+    for (sequence, _, event, arg8, arg16), time in zip(records, times):
+        gap = time - previous
+        mark = " <<<" if options.slow and gap > options.slow else ""
+        print("{:>8} {:>14.2f} us {:>+10.2f} {:<12} {}{}".format(
+            sequence, time, gap, EVENTS.get(event, str(event)), describe(event, arg8, arg16, tasks), mark))
+        previous = time
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())